@@ -0,0 +1,248 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <climits>
+#include <cstddef>
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "include/core/Order.h"
+
+// The implementations the benchmarks measure against, copied from the code
+// they replaced so both sides run in one program on the same data.
+namespace baseline {
+
+inline std::string now_iso8601() {
+    auto tp = std::chrono::system_clock::now();
+    std::time_t t = std::chrono::system_clock::to_time_t(tp);
+    std::tm lt{};
+#if defined(_WIN32)
+    localtime_s(&lt, &t);
+#else
+    localtime_r(&t, &lt);
+#endif
+    std::ostringstream os;
+    os << std::put_time(&lt, "%Y-%m-%dT%H:%M:%S");
+    return os.str();
+}
+
+class Order {
+public:
+    int id;
+    std::string client;
+    std::string status;
+    std::map<std::string, int, std::less<>> items;
+    double total;
+    std::string createdAt;
+
+    double calcTotal(const std::map<std::string, double, std::less<>>& priceList) const {
+        double s = 0.0;
+        for (const auto& [itemKey, qty] : items) {
+            if (const auto it = priceList.find(itemKey); it != priceList.end())
+                s += it->second * qty;
+        }
+        return std::round(s * 100.0) / 100.0;
+    }
+
+    std::string toLine() const {
+        std::ostringstream os;
+        os.setf(std::ios::fixed);
+        os << std::setprecision(2);
+        os << id << ';' << client << ';' << status << ';' << total << ';' << createdAt << ';';
+        bool first = true;
+        for (const auto& [itemKey, qty] : items) {
+            if (!first) os << ',';
+            os << itemKey << ':' << qty;
+            first = false;
+        }
+        return os.str();
+    }
+
+    static std::optional<Order> fromLine(const std::string& line) {
+        std::istringstream ss(line);
+        Order o;
+        std::string idStr;
+        std::string clientStr;
+        std::string statusStr;
+        std::string totalStr;
+        std::string createdStr;
+        std::string itemsStr;
+
+        if (!std::getline(ss, idStr, ';')) return std::nullopt;
+        if (!std::getline(ss, clientStr, ';')) return std::nullopt;
+        if (!std::getline(ss, statusStr, ';')) return std::nullopt;
+        if (!std::getline(ss, totalStr, ';')) return std::nullopt;
+
+        std::string rest;
+        std::getline(ss, rest);
+        if (std::istringstream restStream(rest); std::getline(restStream, createdStr, ';')) {
+            std::getline(restStream, itemsStr);
+        } else {
+            createdStr.clear();
+            itemsStr = rest;
+        }
+
+        o.id = std::stoi(idStr);
+        o.client = clientStr;
+        o.status = statusStr;
+        {
+            std::string t = totalStr;
+            std::ranges::replace(t, ',', '.');
+            double v = std::stod(t);
+            o.total = std::round(v * 100.0) / 100.0;
+        }
+        o.createdAt = createdStr.empty() ? now_iso8601() : createdStr;
+
+        std::istringstream itemStream(itemsStr);
+        std::string pair;
+        while (std::getline(itemStream, pair, ',')) {
+            const size_t pos = pair.find(':');
+            if (pos != std::string::npos) {
+                const std::string name = pair.substr(0, pos);
+                const int qty = std::stoi(pair.substr(pos + 1));
+                o.items[name] = qty;
+            }
+        }
+        return o;
+    }
+};
+
+template<typename T>
+class SimpleList {
+private:
+    T* data_{nullptr};
+    size_t size_{0};
+    size_t capacity_{0};
+
+    void ensure_capacity(size_t newCap) {
+        if (newCap <= capacity_) return;
+        auto* newData = new T[newCap];
+        for (size_t i = 0; i < size_; ++i)
+            newData[i] = data_[i];
+        delete[] data_;
+        data_ = newData;
+        capacity_ = newCap;
+    }
+
+public:
+    SimpleList() = default;
+    ~SimpleList() { delete[] data_; }
+    SimpleList(const SimpleList&) = delete;
+    SimpleList& operator=(const SimpleList&) = delete;
+
+    void push_back(const T& value) {
+        if (size_ == capacity_)
+            ensure_capacity(capacity_ == 0 ? 2 : capacity_ * 2);
+        data_[size_++] = value;
+    }
+
+    // Not in the original, which could not delete; this is the shifting erase
+    // a contiguous array needs.
+    void erase(size_t idx) {
+        if (idx >= size_) throw std::out_of_range("SimpleList index out of range");
+        for (size_t i = idx + 1; i < size_; ++i)
+            data_[i - 1] = std::move(data_[i]);
+        --size_;
+    }
+
+    size_t size() const { return size_; }
+
+    T& operator[](size_t idx) {
+        if (idx >= size_) throw std::out_of_range("SimpleList index out of range");
+        return data_[idx];
+    }
+
+    T* begin() { return data_; }
+    T* end() { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+};
+
+struct Product {
+    std::string name;
+    double price;
+    int stock;
+};
+
+// The name lookups and stock updates of the original ProductService.
+class ProductService {
+private:
+    std::map<std::string, Product, std::less<>> products_;
+
+public:
+    void put(const std::string& key, Product p) { products_[key] = std::move(p); }
+
+    Product* findProduct(const std::string& name) {
+        std::string key = name;
+        std::ranges::transform(key, key.begin(), [](unsigned char c){ return std::tolower(c); });
+        auto it = products_.find(key);
+        return it != products_.end() ? &it->second : nullptr;
+    }
+
+    const Product* findProduct(const std::string& name) const {
+        std::string key = name;
+        std::ranges::transform(key, key.begin(), [](unsigned char c){ return std::tolower(c); });
+        auto it = products_.find(key);
+        return it != products_.end() ? &it->second : nullptr;
+    }
+
+    void decreaseStock(const std::string& name, int qty) {
+        Product* p = findProduct(name);
+        if (!p) throw std::out_of_range("product not found");
+        if (p->stock < qty) throw std::out_of_range("not enough stock");
+        p->stock -= qty;
+    }
+
+    int getStock(const std::string& name) const {
+        const Product* p = findProduct(name);
+        if (!p) return 0;
+        return p->stock;
+    }
+};
+
+// The per-row work of the orders-view filter before it was compiled: each
+// row lowercases the client name and the filter text and parses the total
+// and id bounds again. std::string stands in for QString.
+struct FilterText {
+    std::string client;
+    std::optional<OrderStatus> status;
+    std::string minTotal;
+    std::string maxTotal;
+    std::string minId;
+    std::string maxId;
+};
+
+inline std::string lowered(std::string s) {
+    std::ranges::transform(s, s.begin(), [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+inline std::optional<Money> toMoney(std::string text) {
+    std::ranges::replace(text, ',', '.');
+    return Money::parse(text);
+}
+
+inline bool matchesFilter(const ::Order& o, const FilterText& f) {
+    if (!f.client.empty() && lowered(std::string(o.client.view())).find(lowered(f.client)) == std::string::npos)
+        return false;
+    if (f.status && o.status != *f.status) return false;
+    if (!f.minTotal.empty()) {
+        if (const auto v = toMoney(f.minTotal); v && o.total < *v) return false;
+    }
+    if (!f.maxTotal.empty()) {
+        if (const auto v = toMoney(f.maxTotal); v && o.total > *v) return false;
+    }
+    const int minId = f.minId.empty() ? INT_MIN : std::stoi(f.minId);
+    const int maxId = f.maxId.empty() ? INT_MAX : std::stoi(f.maxId);
+    return o.id >= minId && o.id <= maxId;
+}
+
+}
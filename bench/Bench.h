@@ -0,0 +1,40 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+
+namespace bench {
+
+inline volatile std::size_t sink = 0;
+
+// Stores a result of the measured loop so the loop is not optimized away.
+inline void keep(std::size_t result) { sink = result; }
+
+// Best wall time of `runs` calls of fn, in seconds.
+template<typename F>
+double bestOf(int runs, F&& fn) {
+    double best = 1e300;
+    for (int r = 0; r < runs; ++r) {
+        const auto t0 = std::chrono::steady_clock::now();
+        fn();
+        const auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+    }
+    return best;
+}
+
+// Data set size from argv[1], so the same program can run smaller or larger.
+inline std::size_t sizeArg(int argc, char** argv, std::size_t fallback) {
+    return argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : fallback;
+}
+
+// Throughputs, higher is better.
+inline void report(std::string_view what, double baseline, double current, const char* unit) {
+    std::printf("%-36.*s baseline %9.2f %s   current %9.2f %s   x%.2f\n", static_cast<int>(what.size()), what.data(),
+                baseline, unit, current, unit, baseline > 0 ? current / baseline : 0.0);
+}
+
+}
@@ -0,0 +1,58 @@
+#include "bench/Bench.h"
+#include "bench/Baseline.h"
+#include "include/core/Order.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Parse and format throughput of the orders text format, in MB/s of line text.
+int main(int argc, char** argv) {
+    const std::size_t n = bench::sizeArg(argc, argv, 300000);
+    std::vector<std::string> lines;
+    lines.reserve(n);
+    std::size_t bytes = 0;
+    for (std::size_t i = 1; i <= n; ++i) {
+        lines.push_back(std::to_string(i) + ";Client " + std::to_string(i % 500) + ";in_progress;" +
+                        std::to_string(i % 1000) + ".25;2024-01-02T03:04:05;apple:3,product-" +
+                        std::to_string(i % 50) + ":12,zz:1");
+        bytes += lines.back().size() + 1;
+    }
+    const double mb = static_cast<double>(bytes) / 1e6;
+
+    std::vector<baseline::Order> oldOrders;
+    std::vector<Order> orders;
+    const double oldParse = bench::bestOf(3, [&] {
+        oldOrders.clear();
+        oldOrders.reserve(n);
+        for (const auto& l : lines) oldOrders.push_back(*baseline::Order::fromLine(l));
+    });
+    const double newParse = bench::bestOf(3, [&] {
+        orders.clear();
+        orders.reserve(n);
+        for (const auto& l : lines) orders.push_back(*Order::fromLine(l));
+    });
+
+    std::size_t mismatches = 0;
+    const double oldFormat = bench::bestOf(3, [&] {
+        std::size_t out = 0;
+        for (const auto& o : oldOrders) out += o.toLine().size();
+        bench::keep(out);
+    });
+    const double newFormat = bench::bestOf(3, [&] {
+        std::string buf;
+        std::size_t out = 0;
+        for (const auto& o : orders) {
+            buf.clear();
+            o.appendLine(buf);
+            out += buf.size();
+        }
+        bench::keep(out);
+    });
+    for (std::size_t i = 0; i < n; ++i) mismatches += oldOrders[i].toLine() != orders[i].toLine();
+
+    std::printf("%zu lines, %.1f MB\n", n, mb);
+    bench::report("parse (fromLine)", mb / oldParse, mb / newParse, "MB/s");
+    bench::report("format (toLine / appendLine)", mb / oldFormat, mb / newFormat, "MB/s");
+    if (mismatches) std::printf("%zu lines formatted differently\n", mismatches);
+    return mismatches ? 1 : 0;
+}
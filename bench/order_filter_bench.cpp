@@ -0,0 +1,80 @@
+#include "bench/Bench.h"
+#include "bench/Baseline.h"
+#include "include/core/OrderFilter.h"
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// Orders-view filtering: a full scan with the client, total and id clauses
+// set, re-parsing the filter text for every row against the compiled
+// OrderFilter. Random filters are checked to select the same rows first.
+int main(int argc, char** argv) {
+    const std::size_t n = bench::sizeArg(argc, argv, 1000000);
+    std::mt19937 rng(25);
+    std::vector<Order> orders(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        orders[i].id = static_cast<int>(i + 1);
+        orders[i].client = std::string_view("Customer Account " + std::to_string(100001 + i));
+        orders[i].status = kAllOrderStatuses[rng() % kAllOrderStatuses.size()];
+        orders[i].total = Money::fromCents(rng() % 100000);
+    }
+    const double count = static_cast<double>(n);
+
+    const char* needles[] = {"", "account 1000", "ACCOUNT 10", "customer", "zzz", "9"};
+    const int idSpan = static_cast<int>(n);
+    std::size_t mismatches = 0;
+    for (int k = 0; k < 40; ++k) {
+        baseline::FilterText text;
+        text.client = needles[rng() % 6];
+        if (rng() % 2) text.status = kAllOrderStatuses[rng() % kAllOrderStatuses.size()];
+        if (rng() % 2) text.minTotal = std::to_string(rng() % 500) + "," + std::to_string(rng() % 100);
+        if (rng() % 2) text.maxTotal = std::to_string(200 + rng() % 800);
+        if (rng() % 2) text.minId = std::to_string(rng() % static_cast<unsigned>(idSpan / 2 + 1));
+        if (rng() % 2) text.maxId = std::to_string(idSpan / 2 + static_cast<int>(rng() % static_cast<unsigned>(idSpan / 2 + 1)));
+
+        OrderFilter::Spec spec;
+        spec.client = text.client;
+        spec.status = text.status;
+        if (!text.minTotal.empty()) spec.minTotal = baseline::toMoney(text.minTotal);
+        if (!text.maxTotal.empty()) spec.maxTotal = baseline::toMoney(text.maxTotal);
+        if (!text.minId.empty()) spec.minId = std::stoi(text.minId);
+        if (!text.maxId.empty()) spec.maxId = std::stoi(text.maxId);
+        const OrderFilter filter(spec);
+        for (std::size_t i = 0; i < n; i += 97)
+            mismatches += filter.matches(orders[i]) != baseline::matchesFilter(orders[i], text);
+    }
+
+    baseline::FilterText text;
+    text.client = "account 10";
+    text.minTotal = "100,50";
+    text.maxTotal = "800";
+    text.minId = "1";
+    text.maxId = std::to_string(idSpan * 9 / 10);
+    OrderFilter::Spec spec;
+    spec.client = text.client;
+    spec.minTotal = Money::fromCents(10050);
+    spec.maxTotal = Money::fromCents(80000);
+    spec.minId = 1;
+    spec.maxId = idSpan * 9 / 10;
+    const OrderFilter filter(spec);
+
+    std::size_t oldHits = 0;
+    std::size_t newHits = 0;
+    const double oldScan = bench::bestOf(3, [&] {
+        oldHits = 0;
+        for (const auto& o : orders) oldHits += baseline::matchesFilter(o, text);
+        bench::keep(oldHits);
+    });
+    const double newScan = bench::bestOf(3, [&] {
+        newHits = 0;
+        for (const auto& o : orders) newHits += filter.matches(o);
+        bench::keep(newHits);
+    });
+
+    std::printf("%zu orders, %zu match\n", n, newHits);
+    bench::report("filter scan", count / oldScan / 1e6, count / newScan / 1e6, "M orders/s");
+    mismatches += oldHits != newHits;
+    if (mismatches) std::printf("%zu filter results differ\n", mismatches);
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,90 @@
+#include "bench/Bench.h"
+#include "bench/Baseline.h"
+#include "include/core/Order.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// Line item storage: calcTotal, order copy and item iteration over orders
+// with 1-5 lines, std::map items priced from a price list against the flat
+// OrderItems with price snapshots.
+int main(int argc, char** argv) {
+    const std::size_t n = bench::sizeArg(argc, argv, 200000);
+    std::mt19937 rng(7);
+    std::vector<std::string> keys;
+    std::map<std::string, double, std::less<>> priceList;
+    std::vector<Money> prices;
+    for (int i = 0; i < 200; ++i) {
+        keys.push_back("product-number-" + std::to_string(i));
+        prices.push_back(Money::fromCents(100 + static_cast<std::int64_t>(rng() % 5000)));
+        priceList[keys.back()] = prices.back().toDouble();
+    }
+
+    std::vector<baseline::Order> oldOrders(n);
+    std::vector<Order> orders(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        oldOrders[i].id = orders[i].id = static_cast<int>(i + 1);
+        oldOrders[i].client = "Client";
+        orders[i].client = std::string_view("Client");
+        const int lines = 1 + static_cast<int>(rng() % 5);
+        for (int j = 0; j < lines; ++j) {
+            const std::size_t k = rng() % keys.size();
+            const int qty = 1 + static_cast<int>(rng() % 3);
+            oldOrders[i].items[keys[k]] = qty;
+            orders[i].items.insert_or_assign(keys[k], qty, prices[k]);
+        }
+    }
+    const double count = static_cast<double>(n);
+
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto cents = static_cast<std::int64_t>(std::llround(oldOrders[i].calcTotal(priceList) * 100.0));
+        mismatches += cents != orders[i].calcTotal().cents();
+    }
+
+    const double oldTotal = bench::bestOf(5, [&] {
+        double sum = 0;
+        for (const auto& o : oldOrders) sum += o.calcTotal(priceList);
+        bench::keep(static_cast<std::size_t>(sum));
+    });
+    const double newTotal = bench::bestOf(5, [&] {
+        Money sum;
+        for (const auto& o : orders) sum += o.calcTotal();
+        bench::keep(static_cast<std::size_t>(sum.cents()));
+    });
+
+    std::vector<baseline::Order> oldCopies;
+    std::vector<Order> copies;
+    oldCopies.reserve(n);
+    copies.reserve(n);
+    const double oldCopy = bench::bestOf(5, [&] {
+        oldCopies.clear();
+        for (const auto& o : oldOrders) oldCopies.push_back(o);
+    });
+    const double newCopy = bench::bestOf(5, [&] {
+        copies.clear();
+        for (const auto& o : orders) copies.push_back(o);
+    });
+
+    const double oldIterate = bench::bestOf(5, [&] {
+        std::size_t sum = 0;
+        for (const auto& o : oldOrders)
+            for (const auto& [key, qty] : o.items) sum += key.size() + static_cast<std::size_t>(qty);
+        bench::keep(sum);
+    });
+    const double newIterate = bench::bestOf(5, [&] {
+        std::size_t sum = 0;
+        for (const auto& o : orders)
+            for (const auto& [key, qty] : o.items) sum += key.size() + static_cast<std::size_t>(qty);
+        bench::keep(sum);
+    });
+
+    std::printf("%zu orders, sizeof(Order) %zu -> %zu\n", n, sizeof(baseline::Order), sizeof(Order));
+    bench::report("calcTotal", count / oldTotal / 1e6, count / newTotal / 1e6, "M/s");
+    bench::report("copy", count / oldCopy / 1e6, count / newCopy / 1e6, "M/s");
+    bench::report("iterate items", count / oldIterate / 1e6, count / newIterate / 1e6, "M/s");
+    if (mismatches) std::printf("%zu totals differ\n", mismatches);
+    return mismatches ? 1 : 0;
+}
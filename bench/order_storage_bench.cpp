@@ -0,0 +1,92 @@
+#include "bench/Bench.h"
+#include "bench/Baseline.h"
+#include "include/core/Order.h"
+#include "include/utils/SimpleList.h"
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// Order storage: append, iteration and erase throughput of the slab list
+// against the original growable array, at 100k and 1M orders (or argv[1]).
+namespace {
+
+std::vector<Order> makeOrders(std::size_t n) {
+    std::vector<Order> out(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        Order& o = out[i];
+        o.id = static_cast<int>(i + 1);
+        o.client = "Client with a longer name " + std::to_string(i % 1000);
+        o.createdAt = Timestamp::fromCivil(2024, 1, 1, static_cast<unsigned>(i % 24));
+        o.items.insert_or_assign("apple", 1, Money::fromCents(150));
+        o.items.insert_or_assign("pear", 2, Money::fromCents(225));
+        o.total = o.calcTotal();
+    }
+    return out;
+}
+
+template<typename List>
+std::size_t sumIds(const List& list) {
+    std::size_t sum = 0;
+    for (const Order& o : list) sum += static_cast<std::size_t>(o.id);
+    return sum;
+}
+
+void run(const std::vector<Order>& src) {
+    const std::size_t n = src.size();
+    const double count = static_cast<double>(n);
+    constexpr std::size_t kErases = 200;
+    std::mt19937 rng(9);
+    std::vector<std::size_t> victims(kErases);
+    for (auto& v : victims) v = rng() % (n - kErases);
+
+    const double oldAppend = bench::bestOf(3, [&] {
+        baseline::SimpleList<Order> list;
+        for (const Order& o : src) list.push_back(o);
+        bench::keep(list.size());
+    });
+    const double newAppend = bench::bestOf(3, [&] {
+        SimpleList<Order> list;
+        for (const Order& o : src) list.insert(o);
+        bench::keep(list.size());
+    });
+
+    baseline::SimpleList<Order> oldList;
+    SimpleList<Order> newList;
+    for (const Order& o : src) {
+        oldList.push_back(o);
+        newList.insert(o);
+    }
+    const double oldScan = bench::bestOf(5, [&] { bench::keep(sumIds(oldList)); });
+    const double newScan = bench::bestOf(5, [&] { bench::keep(sumIds(newList)); });
+
+    // Each erase is followed by an insert, as a rolled-back create would be.
+    const double oldErase = bench::bestOf(1, [&] {
+        for (const std::size_t v : victims) {
+            oldList.erase(v);
+            oldList.push_back(src[v]);
+        }
+    });
+    const double newErase = bench::bestOf(1, [&] {
+        for (const std::size_t v : victims) {
+            newList.erase(v);
+            newList.insert(src[v]);
+        }
+    });
+
+    std::printf("%zu orders\n", n);
+    bench::report("append", count / oldAppend / 1e6, count / newAppend / 1e6, "M/s");
+    bench::report("iterate", count / oldScan / 1e6, count / newScan / 1e6, "M/s");
+    bench::report("erase + insert", kErases / oldErase / 1e3, kErases / newErase / 1e3, "k/s");
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        run(makeOrders(bench::sizeArg(argc, argv, 0)));
+        return 0;
+    }
+    for (const std::size_t n : {std::size_t{100000}, std::size_t{1000000}}) run(makeOrders(n));
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include "bench/Bench.h"
+#include "bench/Baseline.h"
+#include "include/services/OrderService.h"
+#include "include/services/ProductService.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// getStock + decreaseStock by user-typed product name, as addItem used to
+// call them: the original copy-and-lowercase lookup against the case-folding
+// catalog. Also counts heap allocations per call, and times addItem itself.
+// decreaseStock now also re-ranks the product in ProductStats, so the lookup
+// alone is measured separately.
+namespace {
+
+std::size_t allocations = 0;
+
+struct NullProducts : IProductRepository {
+    std::map<std::string, Product, std::less<>> load() override { return {}; }
+    void save(const ProductCatalog&) override {}
+};
+
+struct NullOrders : IRepository {
+    void save(const std::vector<Order>&) override {}
+    std::vector<Order> load() override { return {}; }
+    bool append(const std::vector<OrderMutation>&) override { return true; }
+};
+
+}
+
+void* operator new(std::size_t n) {
+    ++allocations;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+    const std::size_t calls = bench::sizeArg(argc, argv, 1000000);
+    constexpr int kProducts = 200;
+    constexpr int kStock = 1 << 30;
+    std::mt19937 rng(3);
+
+    NullProducts productRepo;
+    ProductService products(productRepo);
+    baseline::ProductService oldProducts;
+    std::vector<std::string> typed;
+    for (int i = 0; i < kProducts; ++i) {
+        const std::string name = "Product-Number-" + std::to_string(i);
+        products.addProduct(name, Money::fromCents(125 + i), kStock);
+        oldProducts.put("product-number-" + std::to_string(i), {name, 1.25 + i / 100.0, kStock});
+        typed.push_back(i % 2 ? name : "PRODUCT-number-" + std::to_string(i));
+    }
+    std::vector<const std::string*> names(calls);
+    for (auto& n : names) n = &typed[rng() % typed.size()];
+
+    std::size_t oldAllocs = allocations;
+    const double oldTime = bench::bestOf(3, [&] {
+        std::size_t sum = 0;
+        for (const std::string* n : names) {
+            sum += static_cast<std::size_t>(oldProducts.getStock(*n));
+            oldProducts.decreaseStock(*n, 1);
+        }
+        bench::keep(sum);
+    });
+    oldAllocs = allocations - oldAllocs;
+
+    std::size_t newAllocs = allocations;
+    const double newTime = bench::bestOf(3, [&] {
+        std::size_t sum = 0;
+        for (const std::string* n : names) {
+            sum += static_cast<std::size_t>(products.getStock(*n));
+            products.decreaseStock(*n, 1);
+        }
+        bench::keep(sum);
+    });
+    newAllocs = allocations - newAllocs;
+
+    const double oldLookup = bench::bestOf(3, [&] {
+        std::size_t sum = 0;
+        for (const std::string* n : names) sum += static_cast<std::size_t>(oldProducts.getStock(*n));
+        bench::keep(sum);
+    });
+    const double newLookup = bench::bestOf(3, [&] {
+        std::size_t sum = 0;
+        for (const std::string* n : names) sum += static_cast<std::size_t>(products.getStock(*n));
+        bench::keep(sum);
+    });
+
+    NullOrders orderRepo;
+    OrderService orders(orderRepo);
+    orders.setProductService(&products);
+    orders.setPrices(products.all());
+    std::vector<int> ids;
+    for (int i = 0; i < 2000; ++i) ids.push_back(orders.create("Client").id);
+    const std::size_t adds = calls / 5;
+    const double addTime = bench::bestOf(1, [&] {
+        for (std::size_t i = 0; i < adds; ++i)
+            orders.addItem(*orders.findById(ids[rng() % ids.size()]), typed[rng() % typed.size()], 1);
+    });
+
+    const double count = static_cast<double>(calls);
+    std::printf("%zu calls over %d products\n", calls, kProducts);
+    bench::report("getStock + decreaseStock", count / oldTime / 1e6, count / newTime / 1e6, "M/s");
+    bench::report("getStock", count / oldLookup / 1e6, count / newLookup / 1e6, "M/s");
+    std::printf("allocations per call: baseline %.2f, current %.2f\n", oldAllocs / (3.0 * count),
+                newAllocs / (3.0 * count));
+    std::printf("addItem: %.2f k/s\n", static_cast<double>(adds) / addTime / 1e3);
+    return 0;
+}
@@ -6,3 +6,6 @@ class CustomException : public std::runtime_error { public: using std::runtime_e
 class ValidationException : public CustomException { public: using CustomException::CustomException; };
 class NotFoundException : public CustomException { public: using CustomException::CustomException; };
 class IoException : public CustomException { public: using CustomException::CustomException; };
+// A storage commit was recorded durably but not applied yet; it is finished
+// by the next commit or at startup, so in-memory state must keep it.
+class CommitPendingException : public IoException { public: using IoException::IoException; };
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "include/core/Order.h"
+
+struct StatusTotals {
+    std::size_t count{0};
+    Money revenue;
+};
+
+// Aggregates kept next to the archived orders so that counters and revenue
+// can be reported without loading any segment.
+struct ArchiveSummary {
+    std::size_t orders{0};
+    int maxId{0};
+    StatusTotals done;
+    StatusTotals canceled;
+};
+
+// Cold storage for closed orders. Archived orders are immutable; each
+// append() adds a new segment and orders() loads segments on first use.
+class IOrderArchive {
+public:
+    virtual ~IOrderArchive() = default;
+    virtual void append(const std::vector<Order>& closed) = 0;
+    virtual const std::vector<Order>& orders() = 0;
+    virtual ArchiveSummary summary() = 0;
+};
@@ -3,10 +3,11 @@
 #include <string>
 #include <functional>
 #include "include/core/Product.h"
+#include "include/core/ProductCatalog.h"
 
 class IProductRepository {
 public:
     virtual ~IProductRepository() = default;
-    virtual void save(const std::map<std::string, Product, std::less<>>& data) = 0;
+    virtual void save(const ProductCatalog& data) = 0;
     virtual std::map<std::string, Product, std::less<>> load() = 0;
 };
@@ -1,10 +1,27 @@
 #pragma once
+#include <cstddef>
 #include <vector>
 #include "include/core/Order.h"
+#include "include/core/OrderMutation.h"
 
 class IRepository {
 public:
     virtual ~IRepository() = default;
     virtual void save(const std::vector<Order>& data) = 0;
     virtual std::vector<Order> load() = 0;
+
+    // Durably records a batch of mutations in one write without rewriting the
+    // store. Returns false when the repository cannot journal them; the caller
+    // must then fall back to save().
+    virtual bool append([[maybe_unused]] const std::vector<OrderMutation>& batch) { return false; }
+
+    // Writes only the given orders (inserted or replaced by id) and drops the
+    // removed ids. Returns false when the repository can only rewrite the whole
+    // store; the caller must then fall back to save().
+    virtual bool saveChanges([[maybe_unused]] const std::vector<Order>& upserts,
+                             [[maybe_unused]] const std::vector<int>& removedIds) { return false; }
+
+    // Stored orders the last load() could not read and left out; a later
+    // save() writes the store without them.
+    virtual std::size_t skippedOnLoad() const { return 0; }
 };
@@ -0,0 +1,10 @@
+#pragma once
+
+// Groups the writes of several stores into one durable step.
+class IStorageTransaction {
+public:
+    virtual ~IStorageTransaction() = default;
+    virtual void begin() = 0;
+    virtual void commit() = 0;
+    virtual void rollback() = 0;
+};
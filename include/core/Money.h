@@ -0,0 +1,103 @@
+#pragma once
+#include <charconv>
+#include <cmath>
+#include <compare>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// Amount of money in integer cents. Sums and products are exact; text is
+// converted only when parsing input and formatting output.
+class Money {
+private:
+    std::int64_t cents_{0};
+
+    constexpr explicit Money(std::int64_t cents) : cents_(cents) {}
+
+public:
+    // Longest formatted value: sign, 19 digits, '.', 2 decimals.
+    static constexpr std::size_t kMaxChars = 24;
+
+    constexpr Money() = default;
+
+    static constexpr Money fromCents(std::int64_t cents) { return Money(cents); }
+    static Money fromDouble(double v) { return Money(std::llround(v * 100.0)); }
+
+    constexpr std::int64_t cents() const { return cents_; }
+    double toDouble() const { return static_cast<double>(cents_) / 100.0; }
+
+    constexpr Money& operator+=(Money o) { cents_ += o.cents_; return *this; }
+    constexpr Money& operator-=(Money o) { cents_ -= o.cents_; return *this; }
+    friend constexpr Money operator+(Money a, Money b) { return a += b; }
+    friend constexpr Money operator-(Money a, Money b) { return a -= b; }
+    friend constexpr Money operator*(Money a, std::int64_t n) { return Money(a.cents_ * n); }
+    friend constexpr Money operator*(std::int64_t n, Money a) { return Money(a.cents_ * n); }
+    friend constexpr auto operator<=>(Money a, Money b) = default;
+
+    // Accepts "12", "12.5", "12,50", "+3.05", "-3.05" with optional leading
+    // whitespace; digits beyond cents are rounded half up.
+    static constexpr std::optional<Money> parse(std::string_view s) {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+        bool negative = false;
+        if (!s.empty() && (s.front() == '+' || s.front() == '-')) {
+            negative = s.front() == '-';
+            s.remove_prefix(1);
+        }
+        std::int64_t units = 0;
+        std::size_t i = 0;
+        for (; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i) {
+            if (units > (INT64_MAX / 100 - 9) / 10) return std::nullopt;
+            units = units * 10 + (s[i] - '0');
+        }
+        const bool hasUnits = i > 0;
+        std::int64_t fraction = 0;
+        int fractionDigits = 0;
+        bool roundUp = false;
+        if (i < s.size() && (s[i] == '.' || s[i] == ',')) {
+            for (++i; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i) {
+                if (fractionDigits < 2) fraction = fraction * 10 + (s[i] - '0');
+                else if (fractionDigits == 2) roundUp = s[i] >= '5';
+                ++fractionDigits;
+            }
+        }
+        if (i != s.size() || (!hasUnits && fractionDigits == 0)) return std::nullopt;
+        if (fractionDigits == 1) fraction *= 10;
+        std::int64_t cents = units * 100 + fraction + (roundUp ? 1 : 0);
+        return Money(negative ? -cents : cents);
+    }
+
+    // Writes "-12.34" into [first, last) and returns the end; no allocation.
+    char* format(char* first, char* last) const {
+        std::int64_t c = cents_;
+        if (c < 0) {
+            if (first != last) *first++ = '-';
+            c = -c;
+        }
+        first = std::to_chars(first, last, c / 100).ptr;
+        if (last - first < 3) return first;
+        const auto frac = static_cast<int>(c % 100);
+        *first++ = '.';
+        *first++ = static_cast<char>('0' + frac / 10);
+        *first++ = static_cast<char>('0' + frac % 10);
+        return first;
+    }
+
+    void appendTo(std::string& out) const {
+        char buf[kMaxChars];
+        out.append(buf, format(buf, buf + sizeof(buf)));
+    }
+
+    std::string toString() const {
+        std::string s;
+        appendTo(s);
+        return s;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, Money m) {
+        char buf[kMaxChars];
+        return os.write(buf, m.format(buf, buf + sizeof(buf)) - buf);
+    }
+};
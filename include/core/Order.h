@@ -1,35 +1,48 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <map>
 #include <functional>
 #include <ostream>
 #include <optional>
 #include <compare>
-#include <iomanip>
+#include "include/core/Money.h"
+#include "include/core/OrderItems.h"
+#include "include/core/PriceTable.h"
+#include "include/core/OrderStatus.h"
+#include "include/core/Timestamp.h"
+#include "include/utils/StringPool.h"
 
 class Order {
 public:
     int id;
-    std::string client;
-    std::string status;
-    std::map<std::string, int, std::less<>> items;
-    double total;
-    std::string createdAt;
+    OrderStatus status{OrderStatus::New};
+    PooledString client;
+    OrderItems items;
+    Money total;
+    Timestamp createdAt;
+    // createdAt as stored when it could not be read: createdAt is then the
+    // epoch, and this text is written back in its place.
+    PooledString createdAtText;
 
-    double calcTotal(const std::map<std::string, double, std::less<>>& priceList) const;
+    // Sum of qty * unit price over the lines, from the prices they captured.
+    Money calcTotal() const;
+    // Gives lines stored before price snapshots the table's current price.
+    // Returns true if any line was priced.
+    bool priceUnpricedLines(const PriceTable& prices);
+    bool createdAtUnreadable() const { return !createdAtText.empty(); }
 
     auto operator<=>(const Order& other) const { return id <=> other.id; }
     bool operator==(const Order& other) const { return id == other.id; }
 
     std::string toLine() const;
-    static std::optional<Order> fromLine(const std::string& line);
+    void appendLine(std::string& out) const;
+    static std::optional<Order> fromLine(std::string_view line);
 
     friend std::ostream& operator<<(std::ostream& os, const Order& o) {
-        os << "Order #" << o.id << " (" << o.client << ") [" << o.status << "]\n";
+        os << "Order #" << o.id << " (" << o.client << ") [" << toString(o.status) << "]\n";
         for (const auto& [itemKey, qty] : o.items)
             os << "  " << itemKey << " x" << qty << "\n";
-        os.setf(std::ios::fixed);
-        os << std::setprecision(2);
         os << "Total: " << o.total << "\n";
         os << "CreatedAt: " << o.createdAt << "\n";
         return os;
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "include/core/Money.h"
+#include "include/core/Order.h"
+#include "include/core/OrderStatus.h"
+#include "include/core/Timestamp.h"
+
+// The orders-view filter, compiled once from what the user entered: bounds
+// are parsed, the client text is case-folded, and clauses left empty are
+// dropped. matches() then tests an order without parsing or allocating.
+class OrderFilter {
+public:
+    struct Spec {
+        std::string_view client;
+        std::optional<OrderStatus> status;
+        std::optional<Money> minTotal;
+        std::optional<Money> maxTotal;
+        std::optional<int> minId;
+        std::optional<int> maxId;
+        std::optional<Timestamp> from;
+        std::optional<Timestamp> to;
+    };
+
+private:
+    enum Clause : std::uint8_t {
+        kClient = 1 << 0,
+        kStatus = 1 << 1,
+        kTotal = 1 << 2,
+        kId = 1 << 3,
+        kCreated = 1 << 4,
+    };
+
+    std::uint8_t clauses_{0};
+    std::u32string client_;
+    OrderStatus status_{OrderStatus::New};
+    Money minTotal_;
+    Money maxTotal_;
+    int minId_{0};
+    int maxId_{0};
+    Timestamp from_;
+    Timestamp to_;
+
+    bool matchesClient(std::string_view client) const;
+
+public:
+    OrderFilter() = default;
+    explicit OrderFilter(const Spec& spec);
+
+    bool empty() const { return clauses_ == 0; }
+
+    // The set clauses, for picking an index to start from.
+    std::optional<OrderStatus> status() const;
+    std::optional<std::pair<int, int>> idRange() const;
+    std::optional<std::pair<Timestamp, Timestamp>> createdRange() const;
+
+    bool matches(const Order& o) const {
+        if ((clauses_ & kId) && (o.id < minId_ || o.id > maxId_)) return false;
+        if ((clauses_ & kStatus) && o.status != status_) return false;
+        if ((clauses_ & kTotal) && (o.total < minTotal_ || o.total > maxTotal_)) return false;
+        if ((clauses_ & kCreated) && (o.createdAt < from_ || o.createdAt > to_)) return false;
+        return !(clauses_ & kClient) || matchesClient(o.client);
+    }
+};
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "include/core/Money.h"
+#include "include/core/ProductKeys.h"
+#include "include/utils/SmallVector.h"
+
+// Line items of an order: product key -> qty and the unit price the line was
+// added at, kept sorted by key in a flat array with inline room for a few
+// lines. Keys are interned, so an item is a pointer and an id rather than its
+// own string; like ProductKeys, lookups ignore ASCII case. Iterates like the
+// std::map it replaces, yielding (const std::string& key, int qty) pairs.
+// A zero price means the line predates price snapshots (product prices are
+// always positive).
+class OrderItems {
+private:
+    struct Slot {
+        const std::string* key;
+        ProductId id;
+        int qty;
+        Money price;
+    };
+    SmallVector<Slot, 4> slots_;
+
+    Slot* lowerBound(std::string_view key);
+    const Slot* lowerBound(std::string_view key) const;
+
+public:
+    using value_type = std::pair<const std::string&, int>;
+
+    class const_iterator {
+        const Slot* p_{nullptr};
+        friend class OrderItems;
+        explicit const_iterator(const Slot* p) : p_(p) {}
+    public:
+        struct Arrow {
+            OrderItems::value_type v;
+            const OrderItems::value_type* operator->() const { return &v; }
+        };
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = OrderItems::value_type;
+        using reference = value_type;
+        using pointer = Arrow;
+
+        const_iterator() = default;
+        value_type operator*() const { return {*p_->key, p_->qty}; }
+        Arrow operator->() const { return {**this}; }
+        ProductId id() const { return p_->id; }
+        int qty() const { return p_->qty; }
+        Money price() const { return p_->price; }
+        const_iterator& operator++() { ++p_; return *this; }
+        const_iterator operator++(int) { const_iterator t = *this; ++p_; return t; }
+        const_iterator& operator--() { --p_; return *this; }
+        const_iterator operator--(int) { const_iterator t = *this; --p_; return t; }
+        bool operator==(const const_iterator&) const = default;
+    };
+    using iterator = const_iterator;
+
+    const_iterator begin() const { return const_iterator(slots_.begin()); }
+    const_iterator end() const { return const_iterator(slots_.end()); }
+    std::size_t size() const { return slots_.size(); }
+    bool empty() const { return slots_.empty(); }
+    void clear() { slots_.clear(); }
+
+    const_iterator find(std::string_view key) const;
+    const_iterator find(ProductId id) const;
+    bool contains(std::string_view key) const { return find(key) != end(); }
+
+    // Inserts the key with qty 0 and no price if missing.
+    int& operator[](std::string_view key);
+    void insert_or_assign(std::string_view key, int qty) { (*this)[key] = qty; }
+    void insert_or_assign(std::string_view key, int qty, Money price);
+    // Reprices the line at `it`, which must be one of this container's.
+    void setPrice(const_iterator it, Money price) { slots_.begin()[it.p_ - slots_.begin()].price = price; }
+    std::size_t erase(std::string_view key);
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include "include/core/Order.h"
+
+class OrderMutation {
+public:
+    enum class Kind { Create, SetItem, SetStatus, Remove };
+
+    Kind kind{Kind::Create};
+    int orderId{0};
+    std::string text;
+    Timestamp createdAt;
+    int qty{0};
+    Money price;
+    OrderStatus status{OrderStatus::New};
+
+    static OrderMutation create(const Order& o) {
+        OrderMutation m;
+        m.kind = Kind::Create;
+        m.orderId = o.id;
+        m.text = o.client;
+        m.createdAt = o.createdAt;
+        return m;
+    }
+
+    static OrderMutation setItem(int orderId, const std::string& itemKey, int qty, Money price = Money()) {
+        OrderMutation m;
+        m.kind = Kind::SetItem;
+        m.orderId = orderId;
+        m.text = itemKey;
+        m.qty = qty;
+        m.price = price;
+        return m;
+    }
+
+    static OrderMutation setStatus(int orderId, OrderStatus status) {
+        OrderMutation m;
+        m.kind = Kind::SetStatus;
+        m.orderId = orderId;
+        m.status = status;
+        return m;
+    }
+
+    static OrderMutation remove(int orderId) {
+        OrderMutation m;
+        m.kind = Kind::Remove;
+        m.orderId = orderId;
+        return m;
+    }
+};
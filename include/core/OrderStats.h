@@ -0,0 +1,79 @@
+#pragma once
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "include/core/IOrderArchive.h"
+#include "include/core/Money.h"
+#include "include/core/OrderStatus.h"
+
+// Order counts and revenue per status over live and archived orders. The
+// owner reports every change (an order entering or leaving a status, a total
+// being repriced, orders reaching the archive), so the dashboards read their
+// aggregates without scanning orders or archive segments.
+class OrderStats {
+private:
+    std::array<StatusTotals, kOrderStatusCount> live_{};
+    ArchiveSummary archived_;
+    Money revenue_;
+
+    const StatusTotals* archivedTotals(OrderStatus s) const {
+        if (s == OrderStatus::Done) return &archived_.done;
+        if (s == OrderStatus::Canceled) return &archived_.canceled;
+        return nullptr;
+    }
+
+public:
+    void clearLive() {
+        for (const auto& t : live_) revenue_ -= t.revenue;
+        live_ = {};
+    }
+
+    void add(OrderStatus s, Money total) {
+        StatusTotals& t = live_[statusIndex(s)];
+        ++t.count;
+        t.revenue += total;
+        revenue_ += total;
+    }
+
+    void remove(OrderStatus s, Money total) {
+        StatusTotals& t = live_[statusIndex(s)];
+        --t.count;
+        t.revenue -= total;
+        revenue_ -= total;
+    }
+
+    void setArchived(const ArchiveSummary& summary) {
+        revenue_ -= archived_.done.revenue + archived_.canceled.revenue;
+        archived_ = summary;
+        revenue_ += archived_.done.revenue + archived_.canceled.revenue;
+    }
+
+    // Orders just written to the archive; their live share is removed separately.
+    void addArchived(const std::vector<Order>& orders) {
+        for (const Order& o : orders) {
+            StatusTotals& t = o.status == OrderStatus::Done ? archived_.done : archived_.canceled;
+            ++t.count;
+            t.revenue += o.total;
+            revenue_ += o.total;
+            ++archived_.orders;
+            archived_.maxId = std::max(archived_.maxId, o.id);
+        }
+    }
+
+    std::size_t liveCount(OrderStatus s) const { return live_[statusIndex(s)].count; }
+    Money liveRevenue(OrderStatus s) const { return live_[statusIndex(s)].revenue; }
+
+    std::size_t count(OrderStatus s) const {
+        const StatusTotals* a = archivedTotals(s);
+        return live_[statusIndex(s)].count + (a ? a->count : 0);
+    }
+
+    Money revenue(OrderStatus s) const {
+        const StatusTotals* a = archivedTotals(s);
+        return live_[statusIndex(s)].revenue + (a ? a->revenue : Money());
+    }
+
+    Money revenue() const { return revenue_; }
+    const ArchiveSummary& archived() const { return archived_; }
+};
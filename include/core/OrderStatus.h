@@ -0,0 +1,43 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+enum class OrderStatus : std::uint8_t { New, InProgress, Done, Canceled };
+
+inline constexpr std::size_t kOrderStatusCount = 4;
+
+inline constexpr std::array<OrderStatus, kOrderStatusCount> kAllOrderStatuses{
+    OrderStatus::New, OrderStatus::InProgress, OrderStatus::Done, OrderStatus::Canceled};
+
+// Text form used by the file formats and the UI.
+constexpr std::string_view toString(OrderStatus s) {
+    switch (s) {
+        case OrderStatus::New: return "new";
+        case OrderStatus::InProgress: return "in_progress";
+        case OrderStatus::Done: return "done";
+        case OrderStatus::Canceled: return "canceled";
+    }
+    return "new";
+}
+
+constexpr std::optional<OrderStatus> parseOrderStatus(std::string_view s) {
+    for (OrderStatus status : kAllOrderStatuses) {
+        if (toString(status) == s) return status;
+    }
+    return std::nullopt;
+}
+
+constexpr bool isActive(OrderStatus s) {
+    return s == OrderStatus::New || s == OrderStatus::InProgress;
+}
+
+constexpr bool isClosed(OrderStatus s) {
+    return !isActive(s);
+}
+
+constexpr std::size_t statusIndex(OrderStatus s) {
+    return static_cast<std::size_t>(s);
+}
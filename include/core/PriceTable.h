@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "include/core/Money.h"
+#include "include/core/ProductKeys.h"
+
+// Unit prices indexed by product id. Looking up a price for an order line
+// is an array access; ids of products that no longer exist have no price.
+// Every actual change bumps version() and stamps the product's slot, so the
+// products repriced since a version the caller saw can be found cheaply.
+class PriceTable {
+private:
+    struct Slot {
+        const std::string* key{nullptr};
+        Money price;
+        std::uint64_t changed{0};
+    };
+    std::vector<Slot> byId_;
+    std::uint64_t version_{0};
+
+public:
+    using value_type = std::pair<const std::string&, Money>;
+
+    class const_iterator {
+        const Slot* p_{nullptr};
+        const Slot* end_{nullptr};
+        friend class PriceTable;
+        const_iterator(const Slot* p, const Slot* end) : p_(p), end_(end) { skip(); }
+        void skip() { while (p_ != end_ && !p_->key) ++p_; }
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = PriceTable::value_type;
+        using reference = value_type;
+
+        const_iterator() = default;
+        value_type operator*() const { return {*p_->key, p_->price}; }
+        const_iterator& operator++() { ++p_; skip(); return *this; }
+        const_iterator operator++(int) { const_iterator t = *this; ++*this; return t; }
+        bool operator==(const const_iterator& o) const { return p_ == o.p_; }
+    };
+
+    const_iterator begin() const { return {byId_.data(), byId_.data() + byId_.size()}; }
+    const_iterator end() const { return {byId_.data() + byId_.size(), byId_.data() + byId_.size()}; }
+
+    void clear() {
+        for (ProductId id = 0; id < byId_.size(); ++id) erase(id);
+    }
+
+    void set(ProductKeys::Key key, Money price) {
+        if (key.id >= byId_.size()) byId_.resize(key.id + 1);
+        Slot& slot = byId_[key.id];
+        if (slot.key == key.name && slot.price == price) return;
+        slot = Slot{key.name, price, ++version_};
+    }
+
+    void erase(ProductId id) {
+        if (id >= byId_.size() || !byId_[id].key) return;
+        byId_[id].key = nullptr;
+        byId_[id].changed = ++version_;
+    }
+
+    // Drops the prices of every product not in `ids`.
+    void keepOnly(const std::vector<ProductId>& ids) {
+        std::vector<bool> keep(byId_.size());
+        for (const ProductId id : ids)
+            if (id < keep.size()) keep[id] = true;
+        for (ProductId id = 0; id < byId_.size(); ++id)
+            if (!keep[id]) erase(id);
+    }
+
+    std::uint64_t version() const { return version_; }
+
+    // Version at which the product's price was last set or erased.
+    std::uint64_t changedAt(ProductId id) const { return id < byId_.size() ? byId_[id].changed : 0; }
+
+    const Money* find(ProductId id) const {
+        return id < byId_.size() && byId_[id].key ? &byId_[id].price : nullptr;
+    }
+
+    const Money* find(std::string_view key) const {
+        const auto k = ProductKeys::find(key);
+        return k ? find(k->id) : nullptr;
+    }
+};
@@ -1,13 +1,14 @@
 #pragma once
 #include <string>
+#include "include/core/Money.h"
 
 class Product {
 public:
     std::string name;
-    double price;
+    Money price;
     int stock;
 
-    Product() : price(0.0), stock(0) {}
-    Product(const std::string& n, double p, int s = 0) : name(n), price(p), stock(s) {}
+    Product() : stock(0) {}
+    Product(const std::string& n, Money p, int s = 0) : name(n), price(p), stock(s) {}
 };
 
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "include/core/Product.h"
+#include "include/core/ProductKeys.h"
+#include "include/utils/CaseFold.h"
+
+// Products addressed by dense id (the ProductKeys id of their lowercase key).
+// Product data sits in one array indexed by id, so code that already holds
+// an id reaches its product with a single index. Lookups by name, in any
+// letter case, go through a case-folding hash; a sorted key -> id map keeps
+// iteration in key order.
+class ProductCatalog {
+private:
+    struct Slot {
+        Product product;
+        bool present{false};
+    };
+    std::vector<Slot> byId_;
+    std::map<std::string, ProductId, CaseInsensitiveLess> byKey_;
+    // Hashed view of byKey_ for lookups; keys point into byKey_'s nodes.
+    std::unordered_map<std::string_view, ProductId, CaseInsensitiveHash, CaseInsensitiveEqual> byName_;
+
+    void indexNames();
+
+public:
+    ProductCatalog() = default;
+    // A copy indexes its own keys; a move takes the map nodes, so the views
+    // in byName_ move along with them.
+    ProductCatalog(const ProductCatalog& other);
+    ProductCatalog& operator=(const ProductCatalog& other);
+    ProductCatalog(ProductCatalog&&) = default;
+    ProductCatalog& operator=(ProductCatalog&&) = default;
+
+    using value_type = std::pair<const std::string&, const Product&>;
+
+    class const_iterator {
+        using Base = std::map<std::string, ProductId, CaseInsensitiveLess>::const_iterator;
+        Base it_;
+        const ProductCatalog* catalog_{nullptr};
+        friend class ProductCatalog;
+        const_iterator(Base it, const ProductCatalog* catalog) : it_(it), catalog_(catalog) {}
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = ProductCatalog::value_type;
+        using reference = value_type;
+
+        const_iterator() = default;
+        value_type operator*() const { return {it_->first, catalog_->byId_[it_->second].product}; }
+        ProductId id() const { return it_->second; }
+        const_iterator& operator++() { ++it_; return *this; }
+        const_iterator operator++(int) { const_iterator t = *this; ++it_; return t; }
+        const_iterator& operator--() { --it_; return *this; }
+        const_iterator operator--(int) { const_iterator t = *this; --it_; return t; }
+        bool operator==(const const_iterator& o) const { return it_ == o.it_; }
+    };
+
+    const_iterator begin() const { return {byKey_.begin(), this}; }
+    const_iterator end() const { return {byKey_.end(), this}; }
+    std::size_t size() const { return byKey_.size(); }
+    bool empty() const { return byKey_.empty(); }
+    bool contains(std::string_view key) const { return byName_.contains(key); }
+
+    std::optional<ProductId> idOf(std::string_view key) const;
+    Product* find(ProductId id);
+    const Product* find(ProductId id) const;
+    Product* find(std::string_view key);
+    const Product* find(std::string_view key) const;
+
+    // Adds or replaces the product stored under the lowercased name and
+    // returns its id.
+    ProductId insert(std::string_view name, Product product);
+    bool erase(std::string_view key);
+    void clear();
+};
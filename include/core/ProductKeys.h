@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+using ProductId = std::uint32_t;
+
+// Process-wide dictionary of product keys. Every distinct key is stored once,
+// lowercased, and gets a dense id; the stored string lives for the rest of
+// the program, so orders keep a pointer to it instead of their own copy.
+// Lookups ignore ASCII case. Safe to call from the parallel order parsers.
+class ProductKeys {
+public:
+    struct Key {
+        const std::string* name;
+        ProductId id;
+    };
+
+    static Key intern(std::string_view key);
+    // Looks a key up without adding it.
+    static std::optional<Key> find(std::string_view key);
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <utility>
+#include <vector>
+#include "include/core/Money.h"
+#include "include/core/Product.h"
+#include "include/core/ProductKeys.h"
+
+// Stock and price rankings plus the total inventory value of a catalog. The
+// owner reports every product added, removed or changed, so a top-K list is
+// the first K entries of an ordered index rather than a sort of the catalog.
+class ProductStats {
+private:
+    std::set<std::pair<int, ProductId>> byStock_;
+    std::set<std::pair<Money, ProductId>> byPrice_;
+    Money inventoryValue_;
+
+    template<typename It>
+    static std::vector<ProductId> take(It first, It last, std::size_t k) {
+        std::vector<ProductId> out;
+        for (; first != last && out.size() < k; ++first) out.push_back(first->second);
+        return out;
+    }
+
+public:
+    void clear() {
+        byStock_.clear();
+        byPrice_.clear();
+        inventoryValue_ = Money();
+    }
+
+    void add(ProductId id, const Product& p) {
+        byStock_.emplace(p.stock, id);
+        byPrice_.emplace(p.price, id);
+        inventoryValue_ += p.price * p.stock;
+    }
+
+    // `p` must be the product as it was reported last.
+    void remove(ProductId id, const Product& p) {
+        byStock_.erase({p.stock, id});
+        byPrice_.erase({p.price, id});
+        inventoryValue_ -= p.price * p.stock;
+    }
+
+    // Re-ranks the existing node, so stock movements do not allocate.
+    void changeStock(ProductId id, const Product& p, int stock) {
+        auto node = byStock_.extract({p.stock, id});
+        if (node.empty()) return;
+        node.value().first = stock;
+        byStock_.insert(std::move(node));
+        inventoryValue_ += p.price * (static_cast<std::int64_t>(stock) - p.stock);
+    }
+
+    std::vector<ProductId> lowestStock(std::size_t k) const { return take(byStock_.begin(), byStock_.end(), k); }
+    std::vector<ProductId> highestStock(std::size_t k) const { return take(byStock_.rbegin(), byStock_.rend(), k); }
+    std::vector<ProductId> cheapest(std::size_t k) const { return take(byPrice_.begin(), byPrice_.end(), k); }
+    std::vector<ProductId> mostExpensive(std::size_t k) const { return take(byPrice_.rbegin(), byPrice_.rend(), k); }
+
+    Money inventoryValue() const { return inventoryValue_; }
+};
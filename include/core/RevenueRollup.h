@@ -0,0 +1,45 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+#include "include/core/IOrderArchive.h"
+#include "include/core/Money.h"
+#include "include/core/OrderStatus.h"
+#include "include/core/Timestamp.h"
+
+enum class RollupGranularity { Hour, Day, Month };
+
+// Order counts and revenue per status, bucketed by the hour, day and month
+// the orders were created in. Each order lands in one bucket per
+// granularity, so a trend over years of history reads a few hundred
+// buckets instead of every order.
+class RevenueRollup {
+public:
+    struct Point {
+        Timestamp start;
+        StatusTotals totals;
+    };
+
+private:
+    using Buckets = std::map<std::int64_t, std::array<StatusTotals, kOrderStatusCount>>;
+    std::array<Buckets, 3> levels_;
+
+    static Timestamp bucketStart(Timestamp t, RollupGranularity g);
+    void apply(Timestamp createdAt, OrderStatus status, Money total, int sign);
+
+public:
+    void clear();
+    void add(Timestamp createdAt, OrderStatus status, Money total) { apply(createdAt, status, total, 1); }
+    void remove(Timestamp createdAt, OrderStatus status, Money total) { apply(createdAt, status, total, -1); }
+
+    // Non-empty buckets overlapping [from, to], oldest first; without a
+    // status the statuses are summed.
+    std::vector<Point> series(Timestamp from, Timestamp to, RollupGranularity g,
+                              std::optional<OrderStatus> status = std::nullopt) const;
+
+    // Buckets holding the oldest and newest rolled-up orders.
+    std::optional<Timestamp> first(RollupGranularity g) const;
+    std::optional<Timestamp> last(RollupGranularity g) const;
+};
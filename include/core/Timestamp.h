@@ -0,0 +1,197 @@
+#pragma once
+#include <chrono>
+#include <compare>
+#include <cstdint>
+#include <ctime>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// Local wall-clock time in whole seconds, counted from 1970-01-01T00:00:00 on
+// the same clock. No time zone is applied, so the count orders exactly like
+// the ISO-8601 text orders are stored as; the text is produced only for
+// display and files.
+class Timestamp {
+private:
+    std::int64_t seconds_{0};
+
+    constexpr explicit Timestamp(std::int64_t seconds) : seconds_(seconds) {}
+
+    static constexpr std::int64_t daysFromCivil(int y, unsigned m, unsigned d) {
+        y -= m <= 2;
+        const int era = (y >= 0 ? y : y - 399) / 400;
+        const auto yoe = static_cast<unsigned>(y - era * 400);
+        const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return std::int64_t{era} * 146097 + doe - 719468;
+    }
+
+    struct Civil {
+        std::int64_t year;
+        unsigned month;
+        unsigned day;
+        std::int64_t secondOfDay;
+    };
+
+    constexpr Civil civil() const {
+        std::int64_t days = seconds_ / 86400;
+        std::int64_t secs = seconds_ % 86400;
+        if (secs < 0) {
+            secs += 86400;
+            --days;
+        }
+        const std::int64_t z = days + 719468;
+        const std::int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+        const auto doe = static_cast<unsigned>(z - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        const unsigned day = doy - (153 * mp + 2) / 5 + 1;
+        const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+        return {static_cast<std::int64_t>(yoe) + era * 400 + (month <= 2), month, day, secs};
+    }
+
+    static constexpr bool isLeap(int y) { return y % 4 == 0 && (y % 100 != 0 || y % 400 == 0); }
+
+    static constexpr unsigned daysInMonth(int y, unsigned m) {
+        constexpr unsigned kDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return m == 2 && isLeap(y) ? 29 : kDays[m - 1];
+    }
+
+public:
+    // "YYYY-MM-DDTHH:MM:SS"
+    static constexpr std::size_t kMaxChars = 19;
+
+    constexpr Timestamp() = default;
+
+    static constexpr Timestamp fromSeconds(std::int64_t seconds) { return Timestamp(seconds); }
+
+    static constexpr Timestamp fromCivil(int year, unsigned month, unsigned day,
+                                         unsigned hour = 0, unsigned minute = 0, unsigned second = 0) {
+        return Timestamp(daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second);
+    }
+
+    static Timestamp local(std::chrono::system_clock::time_point tp) {
+        const std::time_t t = std::chrono::system_clock::to_time_t(tp);
+        std::tm lt{};
+#if defined(_WIN32)
+        localtime_s(&lt, &t);
+#else
+        localtime_r(&t, &lt);
+#endif
+        return fromCivil(lt.tm_year + 1900, static_cast<unsigned>(lt.tm_mon + 1), static_cast<unsigned>(lt.tm_mday),
+                         static_cast<unsigned>(lt.tm_hour), static_cast<unsigned>(lt.tm_min),
+                         static_cast<unsigned>(lt.tm_sec > 59 ? 59 : lt.tm_sec));
+    }
+
+    static Timestamp now() { return local(std::chrono::system_clock::now()); }
+
+    constexpr std::int64_t seconds() const { return seconds_; }
+
+    friend constexpr auto operator<=>(Timestamp a, Timestamp b) = default;
+
+    // Start of the hour, day or month containing this instant.
+    constexpr Timestamp floorHour() const { return Timestamp(seconds_ - ((seconds_ % 3600) + 3600) % 3600); }
+    constexpr Timestamp floorDay() const { return Timestamp(seconds_ - ((seconds_ % 86400) + 86400) % 86400); }
+    constexpr Timestamp floorMonth() const {
+        const Civil c = civil();
+        return fromCivil(static_cast<int>(c.year), c.month, 1);
+    }
+
+    // Accepts "YYYY-MM-DD", optionally followed by 'T' or ' ' and "HH:MM" or
+    // "HH:MM:SS"; fractional seconds are dropped. A time may carry a UTC
+    // offset ("Z", "+HH:MM", "+HHMM" or "+HH"), which is converted to this
+    // machine's local time.
+    static std::optional<Timestamp> parse(std::string_view s) {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+        std::size_t i = 0;
+        const auto digits = [&](std::size_t n, unsigned& out) {
+            if (s.size() - i < n) return false;
+            out = 0;
+            for (std::size_t end = i + n; i < end; ++i) {
+                if (s[i] < '0' || s[i] > '9') return false;
+                out = out * 10 + static_cast<unsigned>(s[i] - '0');
+            }
+            return true;
+        };
+        const auto sep = [&](char c) {
+            if (i >= s.size() || s[i] != c) return false;
+            ++i;
+            return true;
+        };
+
+        unsigned year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+        if (!digits(4, year) || !sep('-') || !digits(2, month) || !sep('-') || !digits(2, day)) return std::nullopt;
+        if (month < 1 || month > 12 || day < 1 || day > daysInMonth(static_cast<int>(year), month)) return std::nullopt;
+        if (i == s.size()) return fromCivil(static_cast<int>(year), month, day);
+
+        if (!sep('T') && !sep(' ')) return std::nullopt;
+        if (!digits(2, hour) || !sep(':') || !digits(2, minute)) return std::nullopt;
+        if (sep(':')) {
+            if (!digits(2, second)) return std::nullopt;
+            if (sep('.')) while (i < s.size() && s[i] >= '0' && s[i] <= '9') ++i;
+        }
+        if (hour > 23 || minute > 59 || second > 59) return std::nullopt;
+        const Timestamp wall = fromCivil(static_cast<int>(year), month, day, hour, minute, second);
+        if (i == s.size()) return wall;
+
+        std::int64_t offset = 0;
+        if (!sep('Z') && !sep('z')) {
+            const bool west = s[i] == '-';
+            if (!sep('+') && !sep('-')) return std::nullopt;
+            unsigned oh = 0, om = 0;
+            if (!digits(2, oh)) return std::nullopt;
+            if (i < s.size()) {
+                sep(':');
+                if (!digits(2, om)) return std::nullopt;
+            }
+            if (oh > 23 || om > 59) return std::nullopt;
+            offset = (west ? -1 : 1) * std::int64_t{oh * 3600 + om * 60};
+        }
+        if (i != s.size()) return std::nullopt;
+        return local(std::chrono::system_clock::time_point(std::chrono::seconds(wall.seconds_ - offset)));
+    }
+
+    // Writes "YYYY-MM-DDTHH:MM:SS" into [first, last) and returns the end;
+    // `sep` replaces the 'T' for display. Needs kMaxChars of room.
+    char* format(char* first, char* last, char sep = 'T') const {
+        if (last - first < static_cast<std::ptrdiff_t>(kMaxChars)) return first;
+        const Civil c = civil();
+        const auto secs = c.secondOfDay;
+
+        const auto put = [&first](unsigned v, int width) {
+            for (int k = width - 1; k >= 0; --k, v /= 10) first[k] = static_cast<char>('0' + v % 10);
+            first += width;
+        };
+        put(static_cast<unsigned>(c.year % 10000), 4);
+        *first++ = '-';
+        put(c.month, 2);
+        *first++ = '-';
+        put(c.day, 2);
+        *first++ = sep;
+        put(static_cast<unsigned>(secs / 3600), 2);
+        *first++ = ':';
+        put(static_cast<unsigned>(secs / 60 % 60), 2);
+        *first++ = ':';
+        put(static_cast<unsigned>(secs % 60), 2);
+        return first;
+    }
+
+    void appendTo(std::string& out) const {
+        char buf[kMaxChars];
+        out.append(buf, format(buf, buf + sizeof(buf)));
+    }
+
+    std::string toString() const {
+        std::string s;
+        appendTo(s);
+        return s;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, Timestamp t) {
+        char buf[kMaxChars];
+        return os.write(buf, t.format(buf, buf + sizeof(buf)) - buf);
+    }
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include "include/core/IRepository.h"
+
+// Versioned binary snapshot of the orders:
+//   header | fixed-width order records | fixed-width item records | string table
+// Strings are deduplicated in the table and referenced by offset/length, so
+// load() maps the file and materializes orders without parsing any text.
+// Version 5 keeps the text of creation dates that could not be read, version 4
+// adds each line's unit price, version 3 stores createdAt as epoch seconds and
+// version 2 totals as integer cents; files written by versions 1 to 4 are
+// still read.
+class BinOrderRepository : public IRepository {
+private:
+    std::string file_;
+    std::size_t skipped_{0};
+public:
+    static constexpr std::uint32_t kVersion = 5;
+
+    explicit BinOrderRepository(std::string f) : file_(std::move(f)) {}
+
+    static std::string encode(const std::vector<Order>& data);
+    // Records that cannot be read are left out and counted in *skipped.
+    static std::vector<Order> decode(std::string_view bytes, const std::string& source,
+                                     std::size_t* skipped = nullptr);
+    void save(const std::vector<Order>& data) override;
+    std::vector<Order> load() override;
+    std::size_t skippedOnLoad() const override { return skipped_; }
+};
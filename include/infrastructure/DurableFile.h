@@ -0,0 +1,18 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+// Replaces `path` with `content` via temp file + fsync + rename, so readers
+// (and a restart after a crash) see either the old or the new file, never a
+// truncated one.
+void writeFileAtomically(const std::string& path, std::string_view content);
+
+// Appends `content` to `path` and fsyncs before returning.
+//
+// Both are staged instead when a FileTransaction is open on this thread.
+void appendFileDurably(const std::string& path, std::string_view content);
+
+// The two halves of writeFileAtomically, never staged: write and fsync
+// `path`, then rename `from` over `to` and sync the directory.
+void writeFileDurably(const std::string& path, std::string_view content);
+void replaceFile(const std::string& from, const std::string& to);
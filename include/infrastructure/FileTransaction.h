@@ -0,0 +1,41 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include "include/core/IStorageTransaction.h"
+
+// While a FileTransaction is open, writeFileAtomically/appendFileDurably are
+// staged instead of performed. commit() writes each staged replace to a
+// synced temp file next to its target, then records the renames and the
+// appended text in one small intent file (atomically), applies them and
+// deletes the intent. recover() re-applies an intent left behind by a crash,
+// so either all stores see the transaction or none do. Staged appends must
+// therefore be idempotent, which the order journal records are.
+class FileTransaction : public IStorageTransaction {
+private:
+    struct Op {
+        char kind;
+        std::string path;
+        std::string content;
+    };
+
+    std::string intentFile_;
+    std::vector<Op> ops_;
+
+    // Intent steps: 'R' renames `content` (a temp file path) over `path`,
+    // 'A' appends `content` to `path`.
+    static void apply(const std::vector<Op>& steps);
+
+public:
+    explicit FileTransaction(std::string intentFile) : intentFile_(std::move(intentFile)) {}
+    ~FileTransaction() override;
+
+    void begin() override;
+    void commit() override;
+    void rollback() override;
+    void recover();
+
+    static FileTransaction* active();
+    void stageReplace(const std::string& path, std::string_view content);
+    void stageAppend(const std::string& path, std::string_view content);
+};
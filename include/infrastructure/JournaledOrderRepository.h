@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#include "include/core/IRepository.h"
+
+// Keeps a full snapshot in another repository plus an append-only journal of
+// mutations. save() writes a fresh snapshot and truncates the journal; load()
+// replays the journal on top of the snapshot.
+class JournaledOrderRepository : public IRepository {
+private:
+    IRepository& snapshot_;
+    std::string journal_;
+    std::size_t compactEvery_;
+    std::size_t records_{0};
+    std::size_t skipped_{0};
+
+    // Returns the number of records that could not be read.
+    static std::size_t replay(std::vector<Order>& data, const std::string& journalText);
+public:
+    JournaledOrderRepository(IRepository& snapshot, std::string journalFile, std::size_t compactEvery = 1000)
+        : snapshot_(snapshot), journal_(std::move(journalFile)), compactEvery_(compactEvery) {}
+
+    void save(const std::vector<Order>& data) override;
+    std::vector<Order> load() override;
+    bool append(const std::vector<OrderMutation>& batch) override;
+    bool saveChanges(const std::vector<Order>& upserts, const std::vector<int>& removedIds) override;
+
+    std::size_t skippedOnLoad() const override { return skipped_; }
+
+    std::size_t journalRecords() const { return records_; }
+};
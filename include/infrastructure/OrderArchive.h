@@ -0,0 +1,38 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "include/core/IOrderArchive.h"
+
+// Archive segments in a directory: each segment is a zlib-compressed binary
+// order snapshot, listed with its summary in manifest.txt. The manifest is
+// rewritten after the segment file, so a segment only becomes visible once
+// it is complete.
+class OrderArchive : public IOrderArchive {
+private:
+    struct Segment {
+        std::string file;
+        std::size_t orders{0};
+        int minId{0};
+        int maxId{0};
+        StatusTotals done;
+        StatusTotals canceled;
+    };
+
+    std::string dir_;
+    std::vector<Segment> segments_;
+    bool manifestRead_{false};
+    std::size_t loadedSegments_{0};
+    std::vector<Order> orders_;
+
+    std::string manifestPath() const;
+    void readManifest();
+    std::vector<Order> loadSegment(const Segment& s) const;
+
+public:
+    explicit OrderArchive(std::string dir) : dir_(std::move(dir)) {}
+
+    void append(const std::vector<Order>& closed) override;
+    const std::vector<Order>& orders() override;
+    ArchiveSummary summary() override;
+};
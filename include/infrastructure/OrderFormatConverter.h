@@ -0,0 +1,5 @@
+#pragma once
+#include <string>
+
+void convertOrdersTxtToBin(const std::string& txtFile, const std::string& binFile);
+void convertOrdersBinToTxt(const std::string& binFile, const std::string& txtFile);
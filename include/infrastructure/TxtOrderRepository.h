@@ -1,12 +1,15 @@
 #pragma once
+#include <cstddef>
 #include <string>
 #include "include/core/IRepository.h"
 
 class TxtOrderRepository : public IRepository {
 private:
     std::string file_;
+    std::size_t skipped_{0};
 public:
     explicit TxtOrderRepository(std::string f) : file_(std::move(f)) {}
     void save(const std::vector<Order>& data) override;
     std::vector<Order> load() override;
+    std::size_t skippedOnLoad() const override { return skipped_; }
 };
@@ -11,5 +11,5 @@ public:
     explicit TxtProductRepository(std::string f) : file_(std::move(f)) {}
 
     std::map<std::string, Product, std::less<>> load() override;
-    void save(const std::map<std::string, Product, std::less<>>& data) override;
+    void save(const ProductCatalog& data) override;
 };
@@ -1,48 +1,197 @@
 #pragma once
 #include <map>
 #include <string>
+#include <string_view>
 #include <functional>
 #include <algorithm>
+#include <vector>
+#include <set>
+#include <array>
+#include <unordered_map>
+#include <cstddef>
+#include <chrono>
 #include "include/core/Order.h"
 #include "include/core/IRepository.h"
-#include "include/core/Product.h"
+#include "include/core/OrderMutation.h"
+#include "include/core/IStorageTransaction.h"
+#include "include/core/IOrderArchive.h"
+#include "include/core/OrderStats.h"
+#include "include/core/RevenueRollup.h"
+#include "include/core/PriceTable.h"
+#include "include/core/ProductCatalog.h"
 #include "include/Errors/CustomExceptions.h"
 #include "include/utils/SimpleList.h"
 
 class ProductService;
 
+struct WriteStats {
+    std::size_t issued{0};
+    std::size_t coalesced{0};
+};
+
 class OrderService {
 private:
     SimpleList<Order> data_;
-    std::map<std::string, double, std::less<>> price_;
+    // id -> slot in data_, and all ids in ascending order for range queries.
+    std::unordered_map<int, size_t> slotById_;
+    std::vector<int> sortedIds_;
+    // (createdAt, id) in ascending order for date-range queries.
+    std::vector<std::pair<Timestamp, int>> byCreated_;
+
+    // product id -> ids of the orders containing it, split into active
+    // (new/in_progress) and closed orders.
+    struct ProductOrders {
+        std::set<int> active;
+        std::set<int> closed;
+    };
+    std::vector<ProductOrders> ordersByProduct_;
+
+    // status -> member ids; statusOf_ remembers what each order contributed
+    // to byStatus_ and stats_ so it can be taken out again.
+    struct IndexedStatus {
+        OrderStatus status{OrderStatus::New};
+        Money total;
+        Timestamp createdAt;
+    };
+    std::array<std::set<int>, kOrderStatusCount> byStatus_;
+    std::unordered_map<int, IndexedStatus> statusOf_;
+    OrderStats stats_;
+    // Built from live and archived orders on first use, then kept current.
+    mutable RevenueRollup rollup_;
+    mutable bool rollupBuilt_{false};
+    PriceTable price_;
+    // Price version open orders were last brought up to.
+    std::uint64_t repricedAt_{0};
     int nextId_{1};
     IRepository& repo_;
     ProductService* productService_{nullptr};
-    void persist();
+
+    IStorageTransaction* storage_{nullptr};
+    IOrderArchive* archive_{nullptr};
+
+    // Pre-images recorded while a unit of work is open, replayed backwards to
+    // roll the in-memory state back.
+    struct UndoEntry {
+        enum class Kind { Changed, Created, Stock } kind;
+        Order order;
+        ProductId productId{0};
+        int stock{0};
+    };
+    struct UnitMark {
+        size_t undo{0};
+        size_t mutations{0};
+        size_t removed{0};
+        size_t archived{0};
+        std::set<int> dirty;
+        bool journalable{true};
+        bool pendingProducts{false};
+        std::uint64_t repricedAt{0};
+    };
+
+    int unitDepth_{0};
+    std::vector<UndoEntry> undo_;
+    std::vector<OrderMutation> pendingMutations_;
+    std::set<int> dirty_;
+    std::vector<int> removed_;
+    std::vector<Order> pendingArchive_;
+    bool journalable_{true};
+    bool pendingProducts_{false};
+    std::size_t pendingRequests_{0};
+    std::size_t skippedOnLoad_{0};
+    WriteStats writeStats_;
+
+    void persist(int orderId);
+    void persist(const OrderMutation& m);
+    void saveProducts();
+    void flush();
+    void saveAll();
+    void clearPending();
+    void indexSlot(size_t slot);
+    void unindexSlot(size_t slot);
+    void reindex();
+    void indexItem(ProductId productId, const Order& o);
+    void unindexItem(ProductId productId, int orderId);
+    const ProductOrders* ordersWithProduct(std::string_view productKey) const;
+    void indexItems(const Order& o);
+    void unindexItems(const Order& o);
+    void indexStatus(const Order& o);
+    void unindexStatus(int orderId);
     void returnItemsToStock(const Order& o);
     void removeItemsFromStock(const Order& o);
+
+    void rememberOrder(const Order& o);
+    void rememberCreated(int id);
+    void rememberStock(ProductId productId);
+    UnitMark beginUnit();
+    void commitUnit(const UnitMark& mark);
+    void rollbackUnit(const UnitMark& mark);
 public:
+    // Batches order and stock mutations in memory. The outermost commit()
+    // writes both stores as one durable step (through the storage transaction
+    // when one is set); if that fails, or the unit is dropped without
+    // commit(), its in-memory changes are rolled back. Nested units act as
+    // savepoints of the enclosing one.
+    class UnitOfWork {
+        OrderService& svc_;
+        UnitMark mark_;
+        bool open_{true};
+    public:
+        explicit UnitOfWork(OrderService& svc) : svc_(svc), mark_(svc.beginUnit()) {}
+        UnitOfWork(const UnitOfWork&) = delete;
+        UnitOfWork& operator=(const UnitOfWork&) = delete;
+        ~UnitOfWork() { if (open_) svc_.rollbackUnit(mark_); }
+        void commit() {
+            open_ = false;
+            svc_.commitUnit(mark_);
+        }
+    };
+
     explicit OrderService(IRepository& repo) : repo_(repo) {}
 
     void setProductService(ProductService* ps) { productService_ = ps; }
-    void setPrices(const std::map<std::string, Product, std::less<>>& products);
-    const std::map<std::string, double, std::less<>>& price() const { return price_; }
+    void setStorageTransaction(IStorageTransaction* tx) { storage_ = tx; }
+    void setArchive(IOrderArchive* archive) { archive_ = archive; }
+    void setPrices(const ProductCatalog& products);
+    const PriceTable& price() const { return price_; }
 
     Order& create(const std::string& client);
-    void addItem(Order& o, const std::string& name, int qty);
-    void removeItem(Order& o, const std::string& name);
-    void setStatus(Order& o, const std::string& s);
+    void addItem(Order& o, std::string_view name, int qty);
+    void removeItem(Order& o, std::string_view name);
+    void setStatus(Order& o, OrderStatus s);
 
     Order* findById(int id);
     const Order* findById(int id) const;
+    std::vector<const Order*> findByIdRange(int minId, int maxId) const;
+    // Orders created within [from, to], oldest first.
+    std::vector<const Order*> findByCreatedRange(Timestamp from, Timestamp to) const;
+    std::size_t countByCreatedRange(Timestamp from, Timestamp to) const;
+
+    Money revenue() const { return stats_.revenue(); }
+    // Moves the lines of new and in-progress orders to the current prices of
+    // products repriced since the last call, in one unit of work; closed
+    // orders keep the prices they were placed at. Returns the orders changed.
+    std::size_t repriceOpenOrders();
+    std::vector<int> activeOrdersWithProduct(std::string_view productKey) const;
+    // Live orders only; stats() also counts the archive.
+    std::size_t countByStatus(OrderStatus status) const;
+    std::vector<const Order*> ordersWithStatus(OrderStatus status) const;
 
-    void sortById();
-    double revenue() const;
-    void recalculateOrdersWithProduct(const std::string& productKey);
+    // Moves done/canceled orders created more than minAge ago out of the
+    // working set into the archive. Returns the number of orders moved.
+    std::size_t archiveClosed(std::chrono::hours minAge);
+    const std::vector<Order>& archived() const;
+    const ArchiveSummary& archiveSummary() const { return stats_.archived(); }
+    const OrderStats& stats() const { return stats_; }
+    const RevenueRollup& rollup() const;
 
     void save();
     void load();
+    // Orders the repository could not read are not in memory, and a write
+    // would drop them from storage, so every write fails until they are fixed
+    // and the orders are loaded again.
+    bool readOnly() const { return skippedOnLoad_ > 0; }
 
     const SimpleList<Order>& all() const { return data_; }
+    const WriteStats& writeStats() const { return writeStats_; }
     int& nextIdRef() { return nextId_; }
 };
@@ -1,34 +1,52 @@
 #pragma once
 #include <map>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <functional>
 #include "include/core/IProductRepository.h"
 #include "include/core/Product.h"
+#include "include/core/ProductCatalog.h"
+#include "include/core/ProductStats.h"
 #include "include/Errors/CustomExceptions.h"
 #include "include/utils/validation_utils.h"
 
 class ProductService {
 private:
-    std::map<std::string, Product, std::less<>> products_;
+    ProductCatalog products_;
+    ProductStats stats_;
     IProductRepository& repo_;
     ValidationService V_;
 
+    // All product changes go through these so that stats_ stays in step.
+    void put(std::string_view name, Product product);
+    bool drop(std::string_view name);
+    void changeStock(ProductId id, Product& p, int stock);
+
 public:
     explicit ProductService(IProductRepository& repo);
 
-    const std::map<std::string, Product, std::less<>>& all() const;
-    Product* findProduct(const std::string& name);
-    const Product* findProduct(const std::string& name) const;
+    const ProductCatalog& all() const;
+    const ProductStats& stats() const { return stats_; }
+    const Product* findProduct(std::string_view name) const;
+    const Product* findProduct(ProductId id) const;
+    std::optional<ProductId> findId(std::string_view name) const;
 
     void load();
     void save();
 
-    void addProduct(const std::string& name, double price, int stock = 0);
-    void removeProduct(const std::string& name);
-    void updateProduct(const std::string& oldName, const std::string& newName, double newPrice, int stock = -1);
+    void addProduct(const std::string& name, Money price, int stock = 0);
+    void removeProduct(std::string_view name);
+    void updateProduct(const std::string& oldName, const std::string& newName, Money newPrice, int stock = -1);
     
-    void decreaseStock(const std::string& name, int qty);
-    void increaseStock(const std::string& name, int qty);
-    bool hasEnoughStock(const std::string& name, int qty) const;
-    int getStock(const std::string& name) const;
-};
\ No newline at end of file
+    void decreaseStock(std::string_view name, int qty);
+    void increaseStock(std::string_view name, int qty);
+    bool hasEnoughStock(std::string_view name, int qty) const;
+    int getStock(std::string_view name) const;
+
+    void setStock(ProductId id, int stock);
+    void decreaseStock(ProductId id, int qty);
+    void increaseStock(ProductId id, int qty);
+    bool hasEnoughStock(ProductId id, int qty) const;
+    int getStock(ProductId id) const;
+};
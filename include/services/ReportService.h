@@ -4,8 +4,6 @@
 #include <QDateTime>
 #include "include/core/Order.h"
 
-class OrderService;
-
 struct ReportFilterInfo {
     QString clientFilter;
     QString statusFilter;
@@ -27,8 +25,7 @@ public:
         bool scopeFiltered,
         bool includeFiltersHeader,
         bool includeSummarySection,
-        const ReportFilterInfo& filterInfo,
-        const OrderService& orderService
+        const ReportFilterInfo& filterInfo
     );
     
 private:
@@ -11,6 +11,9 @@
 #include <QStringListModel>
 #include <QTabWidget>
 #include <string_view>
+#include <utility>
+#include <optional>
+#include "include/core/OrderFilter.h"
 #include "include/services/OrderService.h"
 #include "include/services/ProductService.h"
 #include "include/utils/validation_utils.h"
@@ -60,6 +63,8 @@ struct FilterState {
     QDateTime toDate_;
     bool useFrom_{false};
     bool useTo_{false};
+    // The fields above, parsed once per change of the filter widgets.
+    OrderFilter filter_;
 };
 
 class MainWindow : public QMainWindow {
@@ -90,13 +95,10 @@ private:
     QStringListModel* clientFilterModel_{nullptr};
 
     QList<const Order*> currentFilteredRows() const;
+    bool isFilterActive() const;
+    bool filterReachesArchive() const;
     void applyFilters();
     void setupCompleters();
-    bool matchesClientFilter(const Order& o) const;
-    bool matchesStatusFilter(const Order& o) const;
-    bool matchesTotalFilter(const Order& o) const;
-    bool matchesIdFilter(const Order& o) const;
-    bool matchesDateFilter(const Order& o) const;
     void setupEmptyTableRow();
     void populateTableRow(int row, const Order& o);
     QString formatOrderItems(const Order& o) const;
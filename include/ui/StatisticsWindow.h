@@ -1,10 +1,14 @@
 #pragma once
 #include <QMainWindow>
 #include <QWidget>
+#include <array>
+#include <vector>
 #include "include/services/OrderService.h"
 
+class QComboBox;
 class QLabel;
 class QPushButton;
+class QTabBar;
 class QVBoxLayout;
 class QTimer;
 
@@ -13,9 +17,13 @@ class StatisticsWindow : public QMainWindow {
 private:
     OrderService& svc_;
     QTimer* animationTimer_;
+    QTabBar* views_;
+    QWidget* trendControls_;
+    QComboBox* granularityCombo_;
     double animationProgress_{0.0};
 
     void updateStatistics();
+    void updateTrend();
 
 public:
     explicit StatisticsWindow(OrderService& svc, QWidget* parent = nullptr);
@@ -41,6 +49,17 @@ private:
         double canceledRevenue = 0.0;
     };
     StatusStats stats_;
+
+    // Revenue per status for the most recent buckets of the chosen granularity.
+    struct TrendBucket {
+        Timestamp start;
+        std::array<double, kOrderStatusCount> revenue{};
+    };
+    RollupGranularity granularity_{RollupGranularity::Day};
+    std::vector<TrendBucket> trend_;
+
+    void drawTrendChart(QPainter& painter, const QRect& area, const std::array<QColor, kOrderStatusCount>& colors) const;
+    void drawLegend(QPainter& painter, int y, const std::array<QColor, kOrderStatusCount>& colors) const;
     
     struct RevenueBarParams {
         double revenue{0.0};
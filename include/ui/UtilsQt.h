@@ -1,5 +1,6 @@
 #pragma once
 #include <QString>
+#include <QDateTime>
 #include <QPushButton>
 #include <QWidget>
 #include <QHBoxLayout>
@@ -16,14 +17,35 @@
 #include <string>
 #include <algorithm>
 #include <cctype>
-#include <cmath>
 #include <functional>
+#include <optional>
 #include "include/Errors/CustomExceptions.h"
+#include "include/core/Money.h"
 #include "include/core/Product.h"
+#include "include/core/OrderStatus.h"
+#include "include/core/Timestamp.h"
+#include "include/utils/StringPool.h"
 #include "include/ui/NumericItem.h"
 
 inline QString qs(const std::string& s) { return QString::fromUtf8(s.c_str()); }
 inline std::string ss(const QString& s) { return s.toUtf8().constData(); }
+inline QString qs(PooledString s) { return QString::fromUtf8(s.view().data(), (qsizetype)s.size()); }
+inline QString qs(Money m) {
+    char buf[Money::kMaxChars];
+    return QString::fromLatin1(buf, (qsizetype)(m.format(buf, buf + sizeof(buf)) - buf));
+}
+// Display form: "YYYY-MM-DD HH:MM:SS".
+inline QString qs(Timestamp t) {
+    char buf[Timestamp::kMaxChars];
+    return QString::fromLatin1(buf, (qsizetype)(t.format(buf, buf + sizeof(buf), ' ') - buf));
+}
+inline Timestamp toTimestamp(const QDateTime& dt) {
+    const QDate d = dt.date();
+    const QTime t = dt.time();
+    return Timestamp::fromCivil(d.year(), (unsigned)d.month(), (unsigned)d.day(),
+                                (unsigned)t.hour(), (unsigned)t.minute(), (unsigned)t.second());
+}
+inline QString qs(OrderStatus s) { return QString::fromLatin1(toString(s).data(), (qsizetype)toString(s).size()); }
 
 inline std::string formatName(const std::string& name) {
     if (name.empty()) return name;
@@ -35,17 +57,20 @@ inline std::string formatName(const std::string& name) {
     return result;
 }
 
-inline double parsePrice(const QString& input) {
+inline std::optional<Money> toMoney(const QString& s) {
+    const QByteArray bytes = s.toLatin1();
+    return Money::parse(std::string_view(bytes.constData(), (size_t)bytes.size()));
+}
+
+inline Money parsePrice(const QString& input) {
     QString s = input.trimmed();
     if (s.isEmpty()) throw ValidationException("price cannot be empty");
     s.replace(',', '.');
-    bool ok = false;
-    double price = s.toDouble(&ok);
-    if (!ok || price <= 0.0) throw ValidationException("invalid price");
-    double cents = std::round(price * 100.0);
-    if (std::fabs(price * 100.0 - cents) > 1e-9) throw ValidationException("price must have max 2 decimals");
-    price = cents / 100.0;
-    return price;
+    const auto price = toMoney(s);
+    if (!price || *price <= Money()) throw ValidationException("invalid price");
+    if (const qsizetype dot = s.indexOf('.'); dot >= 0 && s.size() - dot - 1 > 2)
+        throw ValidationException("price must have max 2 decimals");
+    return *price;
 }
 
 inline QPushButton* createEditButton(QWidget* parent, const QString& tooltip = "Edit") {
@@ -115,7 +140,7 @@ struct ProductEditDialogFields {
     QLineEdit* stockEdit{nullptr};
 };
 
-inline ProductEditDialogFields createProductEditDialogFields(QDialog* dialog, const QString& name, double price, int stock) {
+inline ProductEditDialogFields createProductEditDialogFields(QDialog* dialog, const QString& name, Money price, int stock) {
     ProductEditDialogFields fields;
     auto* form = new QFormLayout();
     
@@ -124,7 +149,7 @@ inline ProductEditDialogFields createProductEditDialogFields(QDialog* dialog, co
     form->addRow("Product name:", fields.nameEdit);
     
     fields.priceEdit = new QLineEdit(dialog);
-    fields.priceEdit->setText(QString::number(price, 'f', 2));
+    fields.priceEdit->setText(qs(price));
     form->addRow("Price:", fields.priceEdit);
     
     fields.stockEdit = new QLineEdit(dialog);
@@ -152,7 +177,7 @@ inline ProductTableRowData createProductTableRow(QTableWidget* table, int row, c
     
     data.nameCell = new QTableWidgetItem(qs(prod.name));
     data.nameCell->setTextAlignment(Qt::AlignCenter);
-    data.priceCell = new NumericItem(prod.price, QString::number(prod.price, 'f', 2));
+    data.priceCell = new NumericItem(prod.price.toDouble(), qs(prod.price));
     data.priceCell->setTextAlignment(Qt::AlignCenter);
     data.stockCell = new QTableWidgetItem(QString::number(prod.stock));
     data.stockCell->setTextAlignment(Qt::AlignCenter);
@@ -172,7 +197,7 @@ inline ProductTableRowData createProductTableRow(QTableWidget* table, int row, c
 
 struct ProductEditValidationResult {
     std::string newName;
-    double price{0.0};
+    Money price;
     int stock{0};
     bool isValid{false};
     QString errorMessage;
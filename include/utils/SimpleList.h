@@ -1,97 +1,252 @@
 #pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
-template<typename T>
+// Slab of chunks that are never reallocated; each new chunk doubles the
+// capacity, so a large list is a handful of big blocks. An element keeps its
+// slot from insertion until it is erased: growing never copies or moves
+// elements, and erase leaves a hole that a later insert fills, so references,
+// pointers and slot numbers of the other elements stay valid. Iteration
+// visits occupied slots in slot order.
+template<typename T, size_t ChunkSize = 256>
 class SimpleList {
+    static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two");
+
 private:
-    T* data_{nullptr};
+    // Chunk 0 holds slots [0, ChunkSize), chunk k > 0 holds
+    // [ChunkSize << (k - 1), ChunkSize << k).
+    std::vector<T*> chunks_;
+    std::vector<std::uint64_t> live_;  // one bit per slot handed out
+    std::vector<size_t> free_;
+    size_t slots_{0};
     size_t size_{0};
-    size_t capacity_{0};
 
-    void ensure_capacity(size_t newCap) {
-        if (newCap <= capacity_) return;
-        auto* newData = new T[newCap];
-        for (size_t i = 0; i < size_; ++i)
-            newData[i] = data_[i];
-        delete[] data_;
-        data_ = newData;
-        capacity_ = newCap;
+    static size_t chunkOf(size_t slot) { return static_cast<size_t>(std::bit_width(slot / ChunkSize)); }
+    static size_t chunkBegin(size_t chunk) { return chunk == 0 ? 0 : ChunkSize << (chunk - 1); }
+    static size_t chunkEnd(size_t chunk) { return ChunkSize << chunk; }
+
+    T* at(size_t slot) const {
+        const size_t chunk = chunkOf(slot);
+        return std::launder(chunks_[chunk] + (slot - chunkBegin(chunk)));
+    }
+
+    void addChunk() {
+        const size_t chunk = chunks_.size();
+        chunks_.reserve(chunk + 1);
+        chunks_.push_back(std::allocator<T>().allocate(chunkEnd(chunk) - chunkBegin(chunk)));
+    }
+
+    bool isLive(size_t slot) const { return live_[slot / 64] >> (slot % 64) & 1; }
+    void setLive(size_t slot) { live_[slot / 64] |= std::uint64_t{1} << (slot % 64); }
+    void clearLive(size_t slot) { live_[slot / 64] &= ~(std::uint64_t{1} << (slot % 64)); }
+
+    // First occupied slot at or after `slot`, or slots_; skips holes a word at a time.
+    size_t nextLive(size_t slot) const {
+        while (slot < slots_) {
+            if (const std::uint64_t word = live_[slot / 64] >> (slot % 64))
+                return std::min(slots_, slot + static_cast<size_t>(std::countr_zero(word)));
+            slot = (slot / 64 + 1) * 64;
+        }
+        return slots_;
+    }
+
+    size_t takeSlot() {
+        if (!free_.empty()) {
+            const size_t slot = free_.back();
+            free_.pop_back();
+            return slot;
+        }
+        if (slots_ == capacity()) addChunk();
+        if (slots_ % 64 == 0) live_.push_back(0);
+        return slots_++;
+    }
+
+    void releaseChunks() {
+        for (size_t chunk = 0; chunk < chunks_.size(); ++chunk)
+            std::allocator<T>().deallocate(chunks_[chunk], chunkEnd(chunk) - chunkBegin(chunk));
+        chunks_.clear();
     }
 
+    template<bool Const>
+    class Iter {
+        using List = std::conditional_t<Const, const SimpleList, SimpleList>;
+        List* list_{nullptr};
+        size_t slot_{0};
+        size_t chunkEnd_{0};
+        std::uint64_t bits_{0};  // live bits of slot_'s word, from slot_ on
+        T* elem_{nullptr};
+        friend class SimpleList;
+        Iter(List* list, size_t slot) : list_(list) { seek(list->nextLive(slot)); }
+        void seek(size_t slot) {
+            slot_ = slot;
+            if (slot >= list_->slots_) return;
+            elem_ = list_->at(slot);
+            chunkEnd_ = chunkEnd(chunkOf(slot));
+            bits_ = list_->live_[slot / 64] >> (slot % 64);
+        }
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iter() = default;
+        template<bool C = Const, typename = std::enable_if_t<C>>
+        Iter(const Iter<false>& other)
+            : list_(other.list_), slot_(other.slot_), chunkEnd_(other.chunkEnd_), bits_(other.bits_),
+              elem_(other.elem_) {}
+
+        reference operator*() const { return *elem_; }
+        pointer operator->() const { return elem_; }
+        size_t slot() const { return slot_; }
+
+        // Neighbours in the same chunk are one element apart.
+        Iter& operator++() {
+            bits_ >>= 1;
+            if ((bits_ & 1) && slot_ + 1 < chunkEnd_) {
+                ++slot_;
+                ++elem_;
+            } else {
+                seek(list_->nextLive(slot_ + 1));
+            }
+            return *this;
+        }
+        Iter operator++(int) { Iter t = *this; ++*this; return t; }
+        friend bool operator==(const Iter& a, const Iter& b) { return a.slot_ == b.slot_; }
+
+        friend class Iter<true>;
+    };
+
 public:
     using value_type = T;
+    using iterator = Iter<false>;
+    using const_iterator = Iter<true>;
 
     SimpleList() = default;
-    ~SimpleList() { delete[] data_; }
-    
-    SimpleList(const SimpleList& other) : size_(other.size_), capacity_(other.capacity_) {
-        if (capacity_ > 0) {
-            data_ = new T[capacity_];
-            for (size_t i = 0; i < size_; ++i)
-                data_[i] = other.data_[i];
+    ~SimpleList() {
+        clear();
+        releaseChunks();
+    }
+
+    // The copy has the same elements in the same slots.
+    SimpleList(const SimpleList& other)
+        : live_(other.live_.size(), 0), free_(other.free_), slots_(other.slots_) {
+        reserve(other.slots_);
+        try {
+            for (auto it = other.begin(); it != other.end(); ++it) {
+                ::new (static_cast<void*>(at(it.slot()))) T(*it);
+                setLive(it.slot());
+                ++size_;
+            }
+        } catch (...) {
+            clear();
+            releaseChunks();
+            throw;
         }
     }
-    
+
     SimpleList& operator=(const SimpleList& other) {
         if (this != &other) {
-            delete[] data_;
-            size_ = other.size_;
-            capacity_ = other.capacity_;
-            if (capacity_ > 0) {
-                data_ = new T[capacity_];
-                for (size_t i = 0; i < size_; ++i)
-                    data_[i] = other.data_[i];
-            } else {
-                data_ = nullptr;
-            }
+            SimpleList copy(other);
+            swap(copy);
         }
         return *this;
     }
-    
-    SimpleList(SimpleList&& other) noexcept : data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
-        other.data_ = nullptr;
-        other.size_ = 0;
-        other.capacity_ = 0;
+
+    SimpleList(SimpleList&& other) noexcept
+        : chunks_(std::move(other.chunks_)), live_(std::move(other.live_)), free_(std::move(other.free_)),
+          slots_(std::exchange(other.slots_, 0)), size_(std::exchange(other.size_, 0)) {
+        other.chunks_.clear();
+        other.live_.clear();
+        other.free_.clear();
     }
-    
+
     SimpleList& operator=(SimpleList&& other) noexcept {
         if (this != &other) {
-            delete[] data_;
-            data_ = other.data_;
-            size_ = other.size_;
-            capacity_ = other.capacity_;
-            other.data_ = nullptr;
-            other.size_ = 0;
-            other.capacity_ = 0;
+            SimpleList moved(std::move(other));
+            swap(moved);
         }
         return *this;
     }
 
-    void push_back(const T& value) {
-        if (size_ == capacity_)
-            ensure_capacity(capacity_ == 0 ? 2 : capacity_ * 2);
-        data_[size_++] = value;
+    void swap(SimpleList& other) noexcept {
+        chunks_.swap(other.chunks_);
+        live_.swap(other.live_);
+        free_.swap(other.free_);
+        std::swap(slots_, other.slots_);
+        std::swap(size_, other.size_);
     }
 
+    void reserve(size_t n) {
+        while (capacity() < n) addChunk();
+        live_.reserve((n + 63) / 64);
+    }
+
+    // Constructs the element in a free slot and returns that slot.
+    template<typename... Args>
+    size_t emplace(Args&&... args) {
+        const size_t slot = takeSlot();
+        try {
+            ::new (static_cast<void*>(at(slot))) T(std::forward<Args>(args)...);
+        } catch (...) {
+            free_.push_back(slot);
+            throw;
+        }
+        setLive(slot);
+        ++size_;
+        return slot;
+    }
+
+    size_t insert(const T& value) { return emplace(value); }
+    size_t insert(T&& value) { return emplace(std::move(value)); }
+
+    void erase(size_t slot) {
+        if (!contains(slot)) throw std::out_of_range("SimpleList slot is empty");
+        std::destroy_at(at(slot));
+        clearLive(slot);
+        free_.push_back(slot);
+        --size_;
+    }
+
+    bool contains(size_t slot) const { return slot < slots_ && isLive(slot); }
     size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return chunks_.empty() ? 0 : chunkEnd(chunks_.size() - 1); }
 
-    T& operator[](size_t idx) {
-        if (idx >= size_) throw std::out_of_range("SimpleList index out of range");
-        return data_[idx];
+    T& operator[](size_t slot) {
+        if (!contains(slot)) throw std::out_of_range("SimpleList slot is empty");
+        return *at(slot);
     }
 
-    const T& operator[](size_t idx) const {
-        if (idx >= size_) throw std::out_of_range("SimpleList index out of range");
-        return data_[idx];
+    const T& operator[](size_t slot) const {
+        if (!contains(slot)) throw std::out_of_range("SimpleList slot is empty");
+        return *at(slot);
     }
 
-    T* begin() { return data_; }
-    T* end() { return data_ + size_; }
-    const T* begin() const { return data_; }
-    const T* end() const { return data_ + size_; }
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, slots_}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, slots_}; }
 
-    void clear() { size_ = 0; }
+    // Destroys the elements but keeps the chunks for reuse.
+    void clear() {
+        for (size_t slot = nextLive(0); slot < slots_; slot = nextLive(slot + 1)) std::destroy_at(at(slot));
+        live_.clear();
+        free_.clear();
+        slots_ = 0;
+        size_ = 0;
+    }
 };
 
 template<typename Container, typename Predicate>
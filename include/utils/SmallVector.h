@@ -0,0 +1,116 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+// Vector with room for N elements inside the object; only longer sequences
+// go to the heap. Limited to trivially copyable element types so growth and
+// copies are plain memcpy.
+template<typename T, size_t N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable_v<T>, "SmallVector holds trivially copyable types only");
+    static_assert(N > 0, "SmallVector needs inline capacity");
+
+private:
+    T* data_;
+    std::uint32_t size_{0};
+    std::uint32_t capacity_{N};
+    T inline_[N];
+
+    bool isInline() const { return data_ == inline_; }
+
+    void grow(size_t minCapacity) {
+        const size_t cap = std::max<size_t>(minCapacity, size_t{capacity_} * 2);
+        auto heap = std::make_unique<T[]>(cap);
+        std::memcpy(heap.get(), data_, size_ * sizeof(T));
+        if (!isInline()) delete[] data_;
+        data_ = heap.release();
+        capacity_ = static_cast<std::uint32_t>(cap);
+    }
+
+    void assign(const SmallVector& other) {
+        if (other.size_ > capacity_) grow(other.size_);
+        std::memcpy(data_, other.data_, other.size_ * sizeof(T));
+        size_ = other.size_;
+    }
+
+    void steal(SmallVector& other) noexcept {
+        if (other.isInline()) {
+            std::memcpy(inline_, other.inline_, other.size_ * sizeof(T));
+            data_ = inline_;
+            capacity_ = N;
+        } else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_;
+            other.capacity_ = N;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() : data_(inline_) {}
+    ~SmallVector() { if (!isInline()) delete[] data_; }
+
+    SmallVector(const SmallVector& other) : data_(inline_) { assign(other); }
+    SmallVector(SmallVector&& other) noexcept : data_(inline_) { steal(other); }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) assign(other);
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            if (!isInline()) delete[] data_;
+            data_ = inline_;
+            steal(other);
+        }
+        return *this;
+    }
+
+    void reserve(size_t n) { if (n > capacity_) grow(n); }
+
+    void push_back(const T& value) { insert(end(), value); }
+
+    iterator insert(const_iterator pos, const T& value) {
+        const size_t idx = static_cast<size_t>(pos - data_);
+        const T copy = value;
+        if (size_ == capacity_) grow(size_t{size_} + 1);
+        std::memmove(data_ + idx + 1, data_ + idx, (size_ - idx) * sizeof(T));
+        data_[idx] = copy;
+        ++size_;
+        return data_ + idx;
+    }
+
+    iterator erase(const_iterator pos) {
+        const size_t idx = static_cast<size_t>(pos - data_);
+        if (idx >= size_) throw std::out_of_range("SmallVector index out of range");
+        std::memmove(data_ + idx, data_ + idx + 1, (size_ - idx - 1) * sizeof(T));
+        --size_;
+        return data_ + idx;
+    }
+
+    void clear() { size_ = 0; }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }
+
+    T& operator[](size_t idx) { return data_[idx]; }
+    const T& operator[](size_t idx) const { return data_[idx]; }
+
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+};
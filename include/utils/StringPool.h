@@ -0,0 +1,99 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <compare>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// Append-only arena of distinct strings. Text is copied into large blocks
+// once per distinct value and never moves or dies, so the returned views stay
+// valid for the lifetime of the pool. Safe to call from the parallel order
+// parsers.
+class StringPool {
+private:
+    static constexpr std::size_t kBlockSize = 64 * 1024;
+
+    std::shared_mutex mutex_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    std::vector<std::unique_ptr<char[]>> large_;  // text too long to share a block
+    std::size_t used_{kBlockSize};
+    std::unordered_set<std::string_view> index_;
+
+    std::string_view store(std::string_view s) {
+        char* p = nullptr;
+        if (s.size() > kBlockSize / 4) {
+            p = large_.emplace_back(std::make_unique<char[]>(s.size())).get();
+        } else {
+            if (kBlockSize - used_ < s.size()) {
+                blocks_.emplace_back(std::make_unique<char[]>(kBlockSize));
+                used_ = 0;
+            }
+            p = blocks_.back().get() + used_;
+            used_ += s.size();
+        }
+        std::memcpy(p, s.data(), s.size());
+        return {p, s.size()};
+    }
+
+public:
+    StringPool() = default;
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    std::string_view intern(std::string_view s) {
+        if (s.empty()) return {};
+        {
+            std::shared_lock lock(mutex_);
+            if (const auto it = index_.find(s); it != index_.end()) return *it;
+        }
+        std::unique_lock lock(mutex_);
+        if (const auto it = index_.find(s); it != index_.end()) return *it;
+        return *index_.insert(store(s)).first;
+    }
+
+    // Pool behind PooledString.
+    static StringPool& shared() {
+        static StringPool pool;
+        return pool;
+    }
+
+    // intern() on the shared pool, remembering results per thread so that
+    // parser threads find repeated values without touching the pool's lock.
+    static std::string_view internShared(std::string_view s) {
+        thread_local std::unordered_set<std::string_view> seen;
+        if (const auto it = seen.find(s); it != seen.end()) return *it;
+        const std::string_view pooled = shared().intern(s);
+        if (!pooled.empty()) seen.insert(pooled);
+        return pooled;
+    }
+};
+
+// Immutable text interned in StringPool::shared(): a view instead of an owned
+// std::string, so repeated values (client names) share one copy.
+class PooledString {
+private:
+    std::string_view s_;
+
+public:
+    PooledString() = default;
+    PooledString(std::string_view s) : s_(StringPool::internShared(s)) {}
+    PooledString(const std::string& s) : PooledString(std::string_view(s)) {}
+
+    std::string_view view() const { return s_; }
+    operator std::string_view() const { return s_; }
+    std::string str() const { return std::string(s_); }
+    std::size_t size() const { return s_.size(); }
+    bool empty() const { return s_.empty(); }
+
+    friend bool operator==(PooledString a, std::string_view b) { return a.s_ == b; }
+    friend auto operator<=>(PooledString a, std::string_view b) { return a.s_ <=> b; }
+
+    friend std::ostream& operator<<(std::ostream& os, PooledString s) { return os << s.s_; }
+};
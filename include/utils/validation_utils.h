@@ -1,16 +1,13 @@
 #pragma once
 #include <regex>
 #include <string>
-#include <cmath>
 #include "include/Errors/CustomExceptions.h"
+#include "include/core/Money.h"
+#include "include/core/OrderStatus.h"
 
 class ValidationService {
 private:
     std::regex re;
-    static inline bool money_precision_ok(double v) {
-        double cents = std::round(v * 100.0);
-        return std::fabs(v * 100.0 - cents) < 1e-9;
-    }
 public:
     void validate_client_name(const std::string& name) {
         re = std::regex(R"(^[A-Za-zА-Яа-яЁё0-9]+(?:[ .-][A-Za-zА-Яа-яЁё0-9]+)*$)");
@@ -23,21 +20,16 @@ public:
     void validate_qty(int qty) const {
         if (qty <= 0) throw ValidationException("qty must be positive");
     }
-    void validate_status(std::string_view s) const {
-        if (s != "new" && s != "in_progress" && s != "done" && s != "canceled")
-            throw ValidationException("invalid status");
+    OrderStatus validate_status(std::string_view s) const {
+        const auto status = parseOrderStatus(s);
+        if (!status) throw ValidationException("invalid status");
+        return *status;
     }
     void validate_id(int id) const {
         if (id <= 0) throw ValidationException("id must be positive");
     }
-    void validate_price(double price) const {
-        if (!(price > 0.0)) throw ValidationException("price must be positive");
-        if (!money_precision_ok(price)) throw ValidationException("price must have max 2 decimals");
-    }
-    double normalize_money(double v) const {
-        if (!(v >= 0.0)) throw ValidationException("money must be non-negative");
-        double r = std::round(v * 100.0) / 100.0;
-        return r;
+    void validate_price(Money price) const {
+        if (price <= Money()) throw ValidationException("price must be positive");
     }
 };
 
@@ -1,93 +1,140 @@
 #include "include/core/Order.h"
-#include <sstream>
-#include <chrono>
-#include <iomanip>
-#include <ctime>
-#include <algorithm>
-#include <cmath>
+#include <cctype>
+#include <charconv>
 
-static std::string now_iso8601() {
-    auto tp = std::chrono::system_clock::now();
-    std::time_t t = std::chrono::system_clock::to_time_t(tp);
-    std::tm lt{};
-#if defined(_WIN32)
-    localtime_s(&lt, &t);
-#else
-    localtime_r(&t, &lt);
-#endif
-    std::ostringstream os;
-    os << std::put_time(&lt, "%Y-%m-%dT%H:%M:%S");
-    return os.str();
+Money Order::calcTotal() const {
+    Money s;
+    for (auto it = items.begin(); it != items.end(); ++it) s += it.price() * it.qty();
+    return s;
 }
 
-double Order::calcTotal(const std::map<std::string, double, std::less<>>& priceList) const {
-    double s = 0.0;
-    for (const auto& [itemKey, qty] : items) {
-        if (const auto it = priceList.find(itemKey); it != priceList.end())
-            s += it->second * qty;
+bool Order::priceUnpricedLines(const PriceTable& prices) {
+    bool priced = false;
+    for (auto it = items.begin(); it != items.end(); ++it) {
+        if (it.price() != Money()) continue;
+        if (const Money* price = prices.find(it.id())) {
+            items.setPrice(it, *price);
+            priced = true;
+        }
     }
-    return std::round(s * 100.0) / 100.0;
+    return priced;
+}
+
+namespace {
+
+std::string_view nextField(std::string_view& rest, char delim) {
+    const size_t pos = rest.find(delim);
+    const std::string_view field = rest.substr(0, pos);
+    rest = pos == std::string_view::npos ? std::string_view() : rest.substr(pos + 1);
+    return field;
+}
+
+std::string_view trimLeft(std::string_view s) {
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) s.remove_prefix(1);
+    return s;
+}
+
+bool parseInt(std::string_view s, int& out) {
+    s = trimLeft(s);
+    if (!s.empty() && s.front() == '+') s.remove_prefix(1);
+    const auto [p, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+    return ec == std::errc() && p != s.data();
+}
+
+void appendInt(std::string& out, int v) {
+    char buf[16];
+    const auto [p, ec] = std::to_chars(buf, buf + sizeof(buf), v);
+    out.append(buf, p);
+}
+
 }
 
 std::string Order::toLine() const {
-    std::ostringstream os;
-    os.setf(std::ios::fixed);
-    os << std::setprecision(2);
-    os << id << ';' << client << ';' << status << ';' << total << ';' << createdAt << ';';
+    std::string line;
+    appendLine(line);
+    return line;
+}
+
+void Order::appendLine(std::string& out) const {
+    appendInt(out, id);
+    out += ';';
+    out += client;
+    out += ';';
+    out += toString(status);
+    out += ';';
+    total.appendTo(out);
+    out += ';';
+    if (createdAtUnreadable()) out += createdAtText;
+    else createdAt.appendTo(out);
+    out += ';';
     bool first = true;
-    for (const auto& [itemKey, qty] : items) {
-        if (!first) os << ',';
-        os << itemKey << ':' << qty;
+    for (auto it = items.begin(); it != items.end(); ++it) {
+        if (!first) out += ',';
+        out += (*it).first;
+        out += ':';
+        appendInt(out, it.qty());
+        if (it.price() != Money()) {
+            out += '@';
+            it.price().appendTo(out);
+        }
         first = false;
     }
-    return os.str();
 }
 
-std::optional<Order> Order::fromLine(const std::string& line) {
-    std::istringstream ss(line);
-    Order o;
-    std::string idStr;
-    std::string clientStr;
-    std::string statusStr;
-    std::string totalStr;
-    std::string createdStr;
-    std::string itemsStr;
+// id;client;status;total;createdAt;items  (items = key:qty@price,...)
+// Legacy lines have no createdAt field: id;client;status;total;items
+// Items written before price snapshots have no "@price".
+std::optional<Order> Order::fromLine(std::string_view line) {
+    std::string_view rest = line;
+    std::string_view fields[4];
+    for (int i = 0; i < 3; ++i) {
+        if (rest.find(';') == std::string_view::npos) return std::nullopt;
+        fields[i] = nextField(rest, ';');
+    }
+    fields[3] = nextField(rest, ';');
 
-    if (!std::getline(ss, idStr, ';')) return std::nullopt;
-    if (!std::getline(ss, clientStr, ';')) return std::nullopt;
-    if (!std::getline(ss, statusStr, ';')) return std::nullopt;
-    if (!std::getline(ss, totalStr, ';')) return std::nullopt;
+    Order o;
+    if (!parseInt(fields[0], o.id)) return std::nullopt;
+    o.client = fields[1];
+    const auto status = parseOrderStatus(fields[2]);
+    if (!status) return std::nullopt;
+    o.status = *status;
+    const auto total = Money::parse(fields[3]);
+    if (!total) return std::nullopt;
+    o.total = *total;
 
-    std::string rest;
-    std::getline(ss, rest);
-    if (std::istringstream restStream(rest); std::getline(restStream, createdStr, ';')) {
-        std::getline(restStream, itemsStr);
-    } else {
-        createdStr.clear();
-        itemsStr = rest;
+    // A line without a creation date predates the field and is stamped now;
+    // one whose date cannot be read keeps the text and gets the epoch.
+    std::string_view itemsStr = rest;
+    std::string_view created;
+    if (const size_t pos = rest.find(';'); pos != std::string_view::npos) {
+        created = rest.substr(0, pos);
+        itemsStr = rest.substr(pos + 1);
     }
-
-    o.id = std::stoi(idStr);
-    o.client = clientStr;
-    o.status = statusStr;
-    {
-        std::string t = totalStr;
-        std::ranges::replace(t, ',', '.');
-        double v = std::stod(t);
-        o.total = std::round(v * 100.0) / 100.0;
+    if (created.empty()) {
+        o.createdAt = Timestamp::now();
+    } else if (const auto createdAt = Timestamp::parse(created)) {
+        o.createdAt = *createdAt;
+    } else {
+        o.createdAt = Timestamp();
+        o.createdAtText = created;
     }
-    o.createdAt = createdStr.empty() ? now_iso8601() : createdStr;
 
-    std::istringstream itemStream(itemsStr);
-    std::string pair;
-    while (std::getline(itemStream, pair, ',')) {
+    while (!itemsStr.empty()) {
+        const std::string_view pair = nextField(itemsStr, ',');
         const size_t pos = pair.find(':');
-        if (pos != std::string::npos) {
-            const std::string name = pair.substr(0, pos);
-            const int qty = std::stoi(pair.substr(pos + 1));
-            o.items[name] = qty;
+        if (pos == std::string_view::npos) continue;
+        std::string_view qtyStr = pair.substr(pos + 1);
+        Money price;
+        if (const size_t at = qtyStr.find('@'); at != std::string_view::npos) {
+            const auto parsed = Money::parse(qtyStr.substr(at + 1));
+            if (!parsed) continue;
+            price = *parsed;
+            qtyStr = qtyStr.substr(0, at);
         }
+        int qty = 0;
+        if (!parseInt(qtyStr, qty)) continue;
+        o.items.insert_or_assign(pair.substr(0, pos), qty, price);
     }
     return o;
 }
-
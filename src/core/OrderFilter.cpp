@@ -0,0 +1,92 @@
+#include "include/core/OrderFilter.h"
+#include <limits>
+
+namespace {
+
+// Decodes the UTF-8 code point at `i` and advances past it; a malformed byte
+// is returned as itself.
+char32_t nextCodePoint(std::string_view s, std::size_t& i) {
+    const auto lead = static_cast<unsigned char>(s[i]);
+    const int extra = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : 0;
+    if (extra == 0 || i + extra >= s.size()) {
+        ++i;
+        return lead;
+    }
+    char32_t cp = lead & (0x3F >> extra);
+    for (int k = 1; k <= extra; ++k) {
+        const auto b = static_cast<unsigned char>(s[i + k]);
+        if ((b & 0xC0) != 0x80) {
+            ++i;
+            return lead;
+        }
+        cp = (cp << 6) | (b & 0x3F);
+    }
+    i += extra + 1;
+    return cp;
+}
+
+// Lower case of ASCII, Latin-1, Greek and Cyrillic capitals; anything else
+// is compared as is.
+constexpr char32_t foldCodePoint(char32_t c) {
+    if (c >= U'A' && c <= U'Z') return c + 0x20;
+    if (c < 0xC0) return c;
+    if (c <= 0xDE && c != 0xD7) return c + 0x20;
+    if (c >= 0x391 && c <= 0x3AB && c != 0x3A2) return c + 0x20;
+    if (c >= 0x410 && c <= 0x42F) return c + 0x20;
+    if (c >= 0x400 && c <= 0x40F) return c + 0x50;
+    return c;
+}
+
+}
+
+OrderFilter::OrderFilter(const Spec& spec) {
+    for (std::size_t i = 0; i < spec.client.size();) client_ += foldCodePoint(nextCodePoint(spec.client, i));
+    if (!client_.empty()) clauses_ |= kClient;
+
+    if (spec.status) {
+        status_ = *spec.status;
+        clauses_ |= kStatus;
+    }
+    if (spec.minTotal || spec.maxTotal) {
+        minTotal_ = spec.minTotal.value_or(Money::fromCents(std::numeric_limits<std::int64_t>::min()));
+        maxTotal_ = spec.maxTotal.value_or(Money::fromCents(std::numeric_limits<std::int64_t>::max()));
+        clauses_ |= kTotal;
+    }
+    if (spec.minId || spec.maxId) {
+        minId_ = spec.minId.value_or(std::numeric_limits<int>::min());
+        maxId_ = spec.maxId.value_or(std::numeric_limits<int>::max());
+        clauses_ |= kId;
+    }
+    if (spec.from || spec.to) {
+        from_ = spec.from.value_or(Timestamp::fromSeconds(std::numeric_limits<std::int64_t>::min()));
+        to_ = spec.to.value_or(Timestamp::fromSeconds(std::numeric_limits<std::int64_t>::max()));
+        clauses_ |= kCreated;
+    }
+}
+
+std::optional<OrderStatus> OrderFilter::status() const {
+    if (!(clauses_ & kStatus)) return std::nullopt;
+    return status_;
+}
+
+std::optional<std::pair<int, int>> OrderFilter::idRange() const {
+    if (!(clauses_ & kId)) return std::nullopt;
+    return std::pair{minId_, maxId_};
+}
+
+std::optional<std::pair<Timestamp, Timestamp>> OrderFilter::createdRange() const {
+    if (!(clauses_ & kCreated)) return std::nullopt;
+    return std::pair{from_, to_};
+}
+
+// Substring search over folded code points, restarting at each code point of
+// the client name.
+bool OrderFilter::matchesClient(std::string_view client) const {
+    for (std::size_t start = 0; start < client.size(); nextCodePoint(client, start)) {
+        std::size_t i = start;
+        std::size_t k = 0;
+        while (k < client_.size() && i < client.size() && foldCodePoint(nextCodePoint(client, i)) == client_[k]) ++k;
+        if (k == client_.size()) return true;
+    }
+    return false;
+}
@@ -0,0 +1,55 @@
+#include "include/core/OrderItems.h"
+#include "include/utils/CaseFold.h"
+#include <algorithm>
+
+namespace {
+
+template<typename SlotPtr>
+SlotPtr lowerBoundIn(SlotPtr first, SlotPtr last, std::string_view key) {
+    return std::lower_bound(first, last, key,
+                            [](const auto& s, std::string_view k) { return CaseInsensitiveLess{}(*s.key, k); });
+}
+
+}
+
+OrderItems::Slot* OrderItems::lowerBound(std::string_view key) {
+    return lowerBoundIn(slots_.begin(), slots_.end(), key);
+}
+
+const OrderItems::Slot* OrderItems::lowerBound(std::string_view key) const {
+    return lowerBoundIn(slots_.begin(), slots_.end(), key);
+}
+
+OrderItems::const_iterator OrderItems::find(std::string_view key) const {
+    const Slot* s = lowerBound(key);
+    return const_iterator(s != slots_.end() && CaseInsensitiveEqual{}(*s->key, key) ? s : slots_.end());
+}
+
+OrderItems::const_iterator OrderItems::find(ProductId id) const {
+    return const_iterator(std::find_if(slots_.begin(), slots_.end(), [id](const Slot& s) { return s.id == id; }));
+}
+
+int& OrderItems::operator[](std::string_view key) {
+    Slot* s = lowerBound(key);
+    if (s != slots_.end() && CaseInsensitiveEqual{}(*s->key, key)) return s->qty;
+    const ProductKeys::Key k = ProductKeys::intern(key);
+    return slots_.insert(s, Slot{k.name, k.id, 0, Money()})->qty;
+}
+
+void OrderItems::insert_or_assign(std::string_view key, int qty, Money price) {
+    Slot* s = lowerBound(key);
+    if (s != slots_.end() && CaseInsensitiveEqual{}(*s->key, key)) {
+        s->qty = qty;
+        s->price = price;
+        return;
+    }
+    const ProductKeys::Key k = ProductKeys::intern(key);
+    slots_.insert(s, Slot{k.name, k.id, qty, price});
+}
+
+std::size_t OrderItems::erase(std::string_view key) {
+    const Slot* s = lowerBound(key);
+    if (s == slots_.end() || !CaseInsensitiveEqual{}(*s->key, key)) return 0;
+    slots_.erase(s);
+    return 1;
+}
@@ -0,0 +1,64 @@
+#include "include/core/ProductCatalog.h"
+
+ProductCatalog::ProductCatalog(const ProductCatalog& other) : byId_(other.byId_), byKey_(other.byKey_) {
+    indexNames();
+}
+
+ProductCatalog& ProductCatalog::operator=(const ProductCatalog& other) {
+    if (this != &other) *this = ProductCatalog(other);
+    return *this;
+}
+
+void ProductCatalog::indexNames() {
+    byName_.clear();
+    byName_.reserve(byKey_.size());
+    for (const auto& [key, id] : byKey_) byName_.emplace(key, id);
+}
+
+std::optional<ProductId> ProductCatalog::idOf(std::string_view key) const {
+    const auto it = byName_.find(key);
+    if (it == byName_.end()) return std::nullopt;
+    return it->second;
+}
+
+Product* ProductCatalog::find(ProductId id) {
+    return id < byId_.size() && byId_[id].present ? &byId_[id].product : nullptr;
+}
+
+const Product* ProductCatalog::find(ProductId id) const {
+    return id < byId_.size() && byId_[id].present ? &byId_[id].product : nullptr;
+}
+
+Product* ProductCatalog::find(std::string_view key) {
+    const auto it = byName_.find(key);
+    return it != byName_.end() ? &byId_[it->second].product : nullptr;
+}
+
+const Product* ProductCatalog::find(std::string_view key) const {
+    const auto it = byName_.find(key);
+    return it != byName_.end() ? &byId_[it->second].product : nullptr;
+}
+
+ProductId ProductCatalog::insert(std::string_view name, Product product) {
+    const ProductKeys::Key k = ProductKeys::intern(name);
+    if (k.id >= byId_.size()) byId_.resize(k.id + 1);
+    byId_[k.id] = Slot{std::move(product), true};
+    const auto [it, inserted] = byKey_.insert_or_assign(*k.name, k.id);
+    if (inserted) byName_.emplace(it->first, k.id);
+    return k.id;
+}
+
+bool ProductCatalog::erase(std::string_view key) {
+    const auto it = byKey_.find(key);
+    if (it == byKey_.end()) return false;
+    byId_[it->second] = Slot{};
+    byName_.erase(it->first);
+    byKey_.erase(it);
+    return true;
+}
+
+void ProductCatalog::clear() {
+    byId_.clear();
+    byName_.clear();
+    byKey_.clear();
+}
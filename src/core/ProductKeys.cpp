@@ -0,0 +1,44 @@
+#include "include/core/ProductKeys.h"
+#include "include/utils/CaseFold.h"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace {
+
+struct Dictionary {
+    std::shared_mutex mutex;
+    std::deque<std::string> names;  // deque keeps element addresses stable
+    std::unordered_map<std::string_view, ProductKeys::Key, CaseInsensitiveHash, CaseInsensitiveEqual> byName;
+};
+
+Dictionary& dictionary() {
+    static Dictionary d;
+    return d;
+}
+
+}
+
+ProductKeys::Key ProductKeys::intern(std::string_view key) {
+    Dictionary& d = dictionary();
+    {
+        std::shared_lock lock(d.mutex);
+        if (const auto it = d.byName.find(key); it != d.byName.end()) return it->second;
+    }
+    std::unique_lock lock(d.mutex);
+    if (const auto it = d.byName.find(key); it != d.byName.end()) return it->second;
+    std::string& name = d.names.emplace_back(key);
+    std::ranges::transform(name, name.begin(), foldCase);
+    const Key k{&name, static_cast<ProductId>(d.names.size() - 1)};
+    d.byName.emplace(name, k);
+    return k;
+}
+
+std::optional<ProductKeys::Key> ProductKeys::find(std::string_view key) {
+    Dictionary& d = dictionary();
+    std::shared_lock lock(d.mutex);
+    if (const auto it = d.byName.find(key); it != d.byName.end()) return it->second;
+    return std::nullopt;
+}
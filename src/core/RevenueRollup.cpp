@@ -0,0 +1,64 @@
+#include "include/core/RevenueRollup.h"
+#include <algorithm>
+#include <iterator>
+
+Timestamp RevenueRollup::bucketStart(Timestamp t, RollupGranularity g) {
+    switch (g) {
+        case RollupGranularity::Hour: return t.floorHour();
+        case RollupGranularity::Day: return t.floorDay();
+        case RollupGranularity::Month: return t.floorMonth();
+    }
+    return t;
+}
+
+void RevenueRollup::apply(Timestamp createdAt, OrderStatus status, Money total, int sign) {
+    for (const auto g : {RollupGranularity::Hour, RollupGranularity::Day, RollupGranularity::Month}) {
+        Buckets& level = levels_[static_cast<std::size_t>(g)];
+        const std::int64_t key = bucketStart(createdAt, g).seconds();
+        // Orders mostly arrive in creation order (the initial build, new
+        // orders), so the newest bucket is tried before searching the tree.
+        Buckets::iterator it;
+        if (!level.empty() && level.rbegin()->first == key) it = std::prev(level.end());
+        else if (level.empty() || level.rbegin()->first < key) it = level.try_emplace(level.end(), key);
+        else it = level.try_emplace(key).first;
+        StatusTotals& t = it->second[statusIndex(status)];
+        if (sign > 0) ++t.count;
+        else --t.count;
+        t.revenue += total * sign;
+        const bool empty = std::ranges::all_of(it->second, [](const StatusTotals& s) { return s.count == 0; });
+        if (empty) level.erase(it);
+    }
+}
+
+void RevenueRollup::clear() {
+    for (auto& level : levels_) level.clear();
+}
+
+std::vector<RevenueRollup::Point> RevenueRollup::series(Timestamp from, Timestamp to, RollupGranularity g,
+                                                        std::optional<OrderStatus> status) const {
+    const Buckets& level = levels_[static_cast<std::size_t>(g)];
+    std::vector<Point> out;
+    const auto last = level.upper_bound(to.seconds());
+    for (auto it = level.lower_bound(bucketStart(from, g).seconds()); it != last; ++it) {
+        Point p{Timestamp::fromSeconds(it->first), {}};
+        for (const auto s : kAllOrderStatuses) {
+            if (status && *status != s) continue;
+            p.totals.count += it->second[statusIndex(s)].count;
+            p.totals.revenue += it->second[statusIndex(s)].revenue;
+        }
+        if (p.totals.count > 0) out.push_back(p);
+    }
+    return out;
+}
+
+std::optional<Timestamp> RevenueRollup::first(RollupGranularity g) const {
+    const Buckets& level = levels_[static_cast<std::size_t>(g)];
+    if (level.empty()) return std::nullopt;
+    return Timestamp::fromSeconds(level.begin()->first);
+}
+
+std::optional<Timestamp> RevenueRollup::last(RollupGranularity g) const {
+    const Buckets& level = levels_[static_cast<std::size_t>(g)];
+    if (level.empty()) return std::nullopt;
+    return Timestamp::fromSeconds(level.rbegin()->first);
+}
@@ -0,0 +1,265 @@
+#include "include/infrastructure/BinOrderRepository.h"
+#include "include/infrastructure/DurableFile.h"
+#include "include/Errors/CustomExceptions.h"
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <fcntl.h>
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr char kMagic[4] = {'O', 'M', 'S', 'B'};
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t byteOrderMark;
+    std::uint32_t reserved;
+    std::uint64_t orderCount;
+    std::uint64_t itemCount;
+    std::uint64_t ordersOffset;
+    std::uint64_t itemsOffset;
+    std::uint64_t stringsOffset;
+    std::uint64_t stringsSize;
+};
+
+struct StrRef {
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+struct OrderRecord {
+    std::int32_t id;
+    std::uint32_t itemsBegin;
+    std::uint32_t itemsCount;
+    std::uint32_t reserved;
+    StrRef client;
+    StrRef status;
+    std::int64_t createdAt;   // versions 1-2: a StrRef to ISO-8601 text
+    std::int64_t totalCents;  // version 1: the bits of a double total
+    StrRef createdAtText;     // versions 1-4: absent, the record ends above
+};
+
+struct ItemRecord {
+    StrRef key;
+    std::int32_t qty;
+    std::uint32_t reserved;
+    std::int64_t priceCents;  // versions 1-3: absent, the record ends above
+};
+
+constexpr std::size_t kOrderRecordSizeV4 = offsetof(OrderRecord, createdAtText);
+constexpr std::size_t kItemRecordSizeV3 = offsetof(ItemRecord, priceCents);
+
+// Keys view the caller's text, which must outlive the table; interned item
+// keys, pooled client names and status literals all do.
+class StringTable {
+    std::string bytes_;
+    std::unordered_map<std::string_view, StrRef> index_;
+public:
+    StrRef add(std::string_view s) {
+        if (const auto it = index_.find(s); it != index_.end()) return it->second;
+        const StrRef ref{static_cast<std::uint32_t>(bytes_.size()), static_cast<std::uint32_t>(s.size())};
+        bytes_ += s;
+        index_.emplace(s, ref);
+        return ref;
+    }
+    const std::string& bytes() const { return bytes_; }
+};
+
+template<typename T>
+void appendPod(std::string& out, const T& v) {
+    out.append(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template<typename T>
+T readPod(const char* p) {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+// Read-only view of the whole file: mmap on POSIX, a plain read elsewhere.
+class MappedFile {
+    const char* data_{nullptr};
+    size_t size_{0};
+#if defined(_WIN32)
+    std::string buffer_;
+#endif
+public:
+    explicit MappedFile(const std::string& path) {
+#if defined(_WIN32)
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return;
+        buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st{};
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                data_ = static_cast<const char*>(p);
+                size_ = static_cast<size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+#endif
+    }
+    ~MappedFile() {
+#if !defined(_WIN32)
+        if (data_) ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+};
+
+}
+
+std::string BinOrderRepository::encode(const std::vector<Order>& data) {
+    StringTable strings;
+    std::string orders;
+    std::string items;
+    orders.reserve(data.size() * sizeof(OrderRecord));
+    std::uint32_t itemCount = 0;
+
+    for (const auto& o : data) {
+        OrderRecord r{};
+        r.id = o.id;
+        r.itemsBegin = itemCount;
+        r.itemsCount = static_cast<std::uint32_t>(o.items.size());
+        r.client = strings.add(o.client);
+        r.status = strings.add(toString(o.status));
+        r.createdAt = o.createdAt.seconds();
+        r.totalCents = o.total.cents();
+        r.createdAtText = strings.add(o.createdAtText);
+        appendPod(orders, r);
+        for (auto it = o.items.begin(); it != o.items.end(); ++it) {
+            ItemRecord ir{};
+            ir.key = strings.add((*it).first);
+            ir.qty = it.qty();
+            ir.priceCents = it.price().cents();
+            appendPod(items, ir);
+        }
+        itemCount += r.itemsCount;
+    }
+
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.byteOrderMark = kByteOrderMark;
+    h.orderCount = data.size();
+    h.itemCount = itemCount;
+    h.ordersOffset = sizeof(Header);
+    h.itemsOffset = h.ordersOffset + orders.size();
+    h.stringsOffset = h.itemsOffset + items.size();
+    h.stringsSize = strings.bytes().size();
+
+    std::string out;
+    out.reserve(h.stringsOffset + h.stringsSize);
+    appendPod(out, h);
+    out += orders;
+    out += items;
+    out += strings.bytes();
+    return out;
+}
+
+std::vector<Order> BinOrderRepository::decode(std::string_view bytes, const std::string& source, std::size_t* skipped) {
+    std::vector<Order> v;
+    if (bytes.size() < sizeof(Header)) return v;
+
+    const auto h = readPod<Header>(bytes.data());
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0)
+        throw IoException("not a binary orders file: " + source);
+    if (h.byteOrderMark != kByteOrderMark)
+        throw IoException("binary orders file has foreign byte order: " + source);
+    if (h.version < 1 || h.version > kVersion)
+        throw IoException("unsupported binary orders version: " + source);
+    const auto fits = [&bytes](std::uint64_t offset, std::uint64_t count, std::uint64_t width) {
+        return offset <= bytes.size() && count <= (bytes.size() - offset) / width;
+    };
+    const std::size_t orderSize = h.version < 5 ? kOrderRecordSizeV4 : sizeof(OrderRecord);
+    const std::size_t itemSize = h.version < 4 ? kItemRecordSizeV3 : sizeof(ItemRecord);
+    if (!fits(h.ordersOffset, h.orderCount, orderSize)
+        || !fits(h.itemsOffset, h.itemCount, itemSize)
+        || !fits(h.stringsOffset, h.stringsSize, 1))
+        throw IoException("truncated binary orders file: " + source);
+
+    const char* orders = bytes.data() + h.ordersOffset;
+    const char* items = bytes.data() + h.itemsOffset;
+    const std::string_view strings(bytes.data() + h.stringsOffset, h.stringsSize);
+    const auto str = [&strings](StrRef ref) {
+        return ref.offset + static_cast<std::uint64_t>(ref.length) <= strings.size()
+            ? strings.substr(ref.offset, ref.length)
+            : std::string_view();
+    };
+
+    // Equal strings share one table entry, so each distinct client name goes
+    // through the pool once.
+    std::unordered_map<std::uint32_t, PooledString> clients;
+    v.reserve(h.orderCount);
+    for (std::uint64_t i = 0; i < h.orderCount; ++i) {
+        OrderRecord r{};
+        std::memcpy(&r, orders + i * orderSize, orderSize);
+        const auto status = parseOrderStatus(str(r.status));
+        Timestamp createdAt = Timestamp::fromSeconds(r.createdAt);
+        std::string_view createdAtText = str(r.createdAtText);
+        if (h.version < 3) {
+            const std::string_view text = str(std::bit_cast<StrRef>(r.createdAt));
+            const auto parsed = text.empty() ? Timestamp::now() : Timestamp::parse(text);
+            createdAt = parsed.value_or(Timestamp());
+            if (!parsed) createdAtText = text;
+        }
+        if (!status) {
+            if (skipped) ++*skipped;
+            continue;
+        }
+        Order o;
+        o.id = r.id;
+        auto [client, fresh] = clients.try_emplace(r.client.offset);
+        if (fresh) client->second = str(r.client);
+        o.client = client->second;
+        o.status = *status;
+        o.createdAt = createdAt;
+        o.createdAtText = createdAtText;
+        o.total = h.version == 1 ? Money::fromDouble(std::bit_cast<double>(r.totalCents))
+                                 : Money::fromCents(r.totalCents);
+        if (r.itemsBegin + static_cast<std::uint64_t>(r.itemsCount) <= h.itemCount) {
+            for (std::uint32_t k = 0; k < r.itemsCount; ++k) {
+                ItemRecord ir{};
+                std::memcpy(&ir, items + (r.itemsBegin + k) * itemSize, itemSize);
+                o.items.insert_or_assign(str(ir.key), ir.qty, Money::fromCents(ir.priceCents));
+            }
+        }
+        v.push_back(std::move(o));
+    }
+    return v;
+}
+
+void BinOrderRepository::save(const std::vector<Order>& data) {
+    writeFileAtomically(file_, encode(data));
+}
+
+std::vector<Order> BinOrderRepository::load() {
+    skipped_ = 0;
+    const MappedFile f(file_);
+    if (!f.data()) return {};
+    return decode(std::string_view(f.data(), f.size()), file_, &skipped_);
+}
@@ -0,0 +1,106 @@
+#include "include/infrastructure/DurableFile.h"
+#include "include/infrastructure/FileTransaction.h"
+#include "include/Errors/CustomExceptions.h"
+#include <filesystem>
+#include <cerrno>
+#include <cstring>
+#include <cstdio>
+#include <fcntl.h>
+#if defined(_WIN32)
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+#if defined(_WIN32)
+int openFile(const std::string& path, int flags) { return _open(path.c_str(), flags | _O_BINARY, _S_IREAD | _S_IWRITE); }
+long long writeSome(int fd, const char* p, size_t n) { return _write(fd, p, static_cast<unsigned>(n)); }
+int syncFile(int fd) { return _commit(fd); }
+int closeFile(int fd) { return _close(fd); }
+#else
+int openFile(const std::string& path, int flags) { return ::open(path.c_str(), flags, 0644); }
+long long writeSome(int fd, const char* p, size_t n) { return ::write(fd, p, n); }
+int syncFile(int fd) { return ::fsync(fd); }
+int closeFile(int fd) { return ::close(fd); }
+#endif
+
+[[noreturn]] void fail(const std::string& what, const std::string& path) {
+    throw IoException(what + ": " + path + " (" + std::strerror(errno) + ")");
+}
+
+void writeAll(int fd, std::string_view content, const std::string& path) {
+    const char* p = content.data();
+    size_t left = content.size();
+    while (left > 0) {
+        const long long n = writeSome(fd, p, left);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            closeFile(fd);
+            fail("cannot write file", path);
+        }
+        p += n;
+        left -= static_cast<size_t>(n);
+    }
+}
+
+void syncParentDir([[maybe_unused]] const std::string& path) {
+#if !defined(_WIN32)
+    std::string dir = std::filesystem::path(path).parent_path().string();
+    if (dir.empty()) dir = ".";
+    if (int fd = ::open(dir.c_str(), O_RDONLY); fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#endif
+}
+
+}
+
+void writeFileDurably(const std::string& path, std::string_view content) {
+    const int fd = openFile(path, O_WRONLY | O_CREAT | O_TRUNC);
+    if (fd < 0) fail("cannot open file for write", path);
+    writeAll(fd, content, path);
+    if (syncFile(fd) != 0) {
+        closeFile(fd);
+        fail("cannot sync file", path);
+    }
+    if (closeFile(fd) != 0) fail("cannot close file", path);
+}
+
+void replaceFile(const std::string& from, const std::string& to) {
+#if defined(_WIN32)
+    if (!MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+        throw IoException("cannot replace file: " + to);
+#else
+    if (std::rename(from.c_str(), to.c_str()) != 0) fail("cannot replace file", to);
+#endif
+    syncParentDir(to);
+}
+
+void writeFileAtomically(const std::string& path, std::string_view content) {
+    if (FileTransaction* tx = FileTransaction::active()) {
+        tx->stageReplace(path, content);
+        return;
+    }
+    const std::string tmp = path + ".tmp";
+    writeFileDurably(tmp, content);
+    replaceFile(tmp, path);
+}
+
+void appendFileDurably(const std::string& path, std::string_view content) {
+    if (FileTransaction* tx = FileTransaction::active()) {
+        tx->stageAppend(path, content);
+        return;
+    }
+    const int fd = openFile(path, O_WRONLY | O_CREAT | O_APPEND);
+    if (fd < 0) fail("cannot open file for append", path);
+    writeAll(fd, content, path);
+    if (syncFile(fd) != 0) {
+        closeFile(fd);
+        fail("cannot sync file", path);
+    }
+    if (closeFile(fd) != 0) fail("cannot close file", path);
+}
@@ -0,0 +1,162 @@
+#include "include/infrastructure/FileTransaction.h"
+#include "include/infrastructure/DurableFile.h"
+#include "include/Errors/CustomExceptions.h"
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+thread_local FileTransaction* current = nullptr;
+
+constexpr std::string_view kIntentMagic = "OMSTX2\n";
+
+bool readSize(std::string_view& in, char delim, size_t& out) {
+    const size_t pos = in.find(delim);
+    if (pos == std::string_view::npos) return false;
+    const auto [p, ec] = std::from_chars(in.data(), in.data() + pos, out);
+    if (ec != std::errc() || p != in.data() + pos) return false;
+    in.remove_prefix(pos + 1);
+    return true;
+}
+
+}
+
+FileTransaction::~FileTransaction() {
+    if (current == this) current = nullptr;
+}
+
+FileTransaction* FileTransaction::active() {
+    return current;
+}
+
+void FileTransaction::begin() {
+    ops_.clear();
+    current = this;
+}
+
+void FileTransaction::stageReplace(const std::string& path, std::string_view content) {
+    const auto it = std::ranges::find(ops_, path, &Op::path);
+    if (it == ops_.end()) {
+        ops_.push_back({'R', path, std::string(content)});
+        return;
+    }
+    it->kind = 'R';
+    it->content = content;
+}
+
+void FileTransaction::stageAppend(const std::string& path, std::string_view content) {
+    const auto it = std::ranges::find(ops_, path, &Op::path);
+    if (it == ops_.end()) {
+        ops_.push_back({'A', path, std::string(content)});
+        return;
+    }
+    it->content += content;
+}
+
+void FileTransaction::apply(const std::vector<Op>& steps) {
+    for (const auto& step : steps) {
+        if (step.kind == 'A') {
+            appendFileDurably(step.path, step.content);
+            continue;
+        }
+        // Already renamed if a crash hit after this step.
+        std::error_code ec;
+        if (std::filesystem::exists(step.content, ec)) replaceFile(step.content, step.path);
+    }
+}
+
+void FileTransaction::commit() {
+    if (current == this) current = nullptr;
+    std::vector<Op> ops;
+    ops.swap(ops_);
+    if (ops.empty()) return;
+    // An earlier intent that could not be applied must not be overwritten.
+    recover();
+    // A single replace or append is already atomic on its own.
+    if (ops.size() == 1) {
+        if (ops.front().kind == 'R') writeFileAtomically(ops.front().path, ops.front().content);
+        else appendFileDurably(ops.front().path, ops.front().content);
+        return;
+    }
+
+    std::vector<Op> steps;
+    steps.reserve(ops.size());
+    try {
+        for (auto& op : ops) {
+            if (op.kind == 'A') {
+                steps.push_back(std::move(op));
+                continue;
+            }
+            std::string tmp = op.path + ".txn";
+            writeFileDurably(tmp, op.content);
+            steps.push_back({'R', std::move(op.path), std::move(tmp)});
+        }
+    } catch (const IoException&) {
+        std::error_code ec;
+        for (const auto& step : steps)
+            if (step.kind == 'R') std::filesystem::remove(step.content, ec);
+        throw;
+    }
+
+    std::string intent(kIntentMagic);
+    for (const auto& step : steps) {
+        intent += step.kind;
+        intent += ' ';
+        intent += std::to_string(step.path.size());
+        intent += ' ';
+        intent += std::to_string(step.content.size());
+        intent += '\n';
+        intent += step.path;
+        intent += step.content;
+    }
+    writeFileAtomically(intentFile_, intent);
+    // The durable intent is the commit point: if applying fails now, the
+    // intent stays behind and recover() finishes the job later.
+    try {
+        apply(steps);
+    } catch (const IoException& e) {
+        throw CommitPendingException(std::string("changes were saved but not applied yet (") + e.what()
+                                     + "); they are completed by the next save or restart");
+    }
+    std::error_code ec;
+    std::filesystem::remove(intentFile_, ec);
+}
+
+void FileTransaction::rollback() {
+    if (current == this) current = nullptr;
+    ops_.clear();
+}
+
+void FileTransaction::recover() {
+    std::ifstream in(intentFile_, std::ios::binary);
+    if (!in) return;
+    const std::string text{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    in.close();
+
+    std::string_view rest(text);
+    if (!rest.starts_with(kIntentMagic))
+        throw IoException("corrupt transaction intent file: " + intentFile_);
+    rest.remove_prefix(kIntentMagic.size());
+
+    std::vector<Op> steps;
+    while (!rest.empty()) {
+        Op op;
+        op.kind = rest.front();
+        size_t pathSize = 0;
+        size_t contentSize = 0;
+        if ((op.kind != 'R' && op.kind != 'A') || rest.size() < 2) break;
+        rest.remove_prefix(2);
+        if (!readSize(rest, ' ', pathSize) || !readSize(rest, '\n', contentSize)
+            || rest.size() < pathSize + contentSize)
+            throw IoException("corrupt transaction intent file: " + intentFile_);
+        op.path = rest.substr(0, pathSize);
+        op.content = rest.substr(pathSize, contentSize);
+        rest.remove_prefix(pathSize + contentSize);
+        steps.push_back(std::move(op));
+    }
+    apply(steps);
+    std::filesystem::remove(intentFile_);
+}
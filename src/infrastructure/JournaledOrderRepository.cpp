@@ -0,0 +1,185 @@
+#include "include/infrastructure/JournaledOrderRepository.h"
+#include "include/infrastructure/DurableFile.h"
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <algorithm>
+#include <charconv>
+#include <string_view>
+
+namespace {
+
+// Journal lines are absolute ("item X now has qty N", "status is now S"), so
+// replaying a record twice leaves the same state as replaying it once.
+//   C;<id>;<client>;<createdAt>
+//   I;<id>;<itemKey>;<qty>[@<unit price>]  (qty 0 removes the item)
+//   S;<id>;<status>
+//   U;<full order line>         (insert or replace)
+//   D;<id>
+std::string encode(const OrderMutation& m) {
+    std::string line;
+    switch (m.kind) {
+        case OrderMutation::Kind::Create:
+            line = "C;" + std::to_string(m.orderId) + ';' + m.text + ';';
+            m.createdAt.appendTo(line);
+            break;
+        case OrderMutation::Kind::SetItem:
+            line = "I;" + std::to_string(m.orderId) + ';' + m.text + ';' + std::to_string(m.qty);
+            if (m.qty > 0 && m.price != Money()) {
+                line += '@';
+                m.price.appendTo(line);
+            }
+            break;
+        case OrderMutation::Kind::SetStatus:
+            line = "S;" + std::to_string(m.orderId) + ';';
+            line += toString(m.status);
+            break;
+        case OrderMutation::Kind::Remove:
+            line = "D;" + std::to_string(m.orderId);
+            break;
+    }
+    line += '\n';
+    return line;
+}
+
+bool parseInt(std::string_view s, int& out) {
+    const auto [p, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+    return ec == std::errc() && p == s.data() + s.size();
+}
+
+std::string_view nextField(std::string_view& rest) {
+    const size_t pos = rest.find(';');
+    std::string_view field = rest.substr(0, pos);
+    rest = pos == std::string_view::npos ? std::string_view() : rest.substr(pos + 1);
+    return field;
+}
+
+}
+
+std::size_t JournaledOrderRepository::replay(std::vector<Order>& data, const std::string& journalText) {
+    std::unordered_map<int, size_t> index;
+    for (size_t i = 0; i < data.size(); ++i) index[data[i].id] = i;
+    std::vector<bool> removed(data.size(), false);
+    bool anyRemoved = false;
+    std::size_t skipped = 0;
+
+    const auto put = [&](Order&& o) {
+        if (const auto it = index.find(o.id); it != index.end()) {
+            data[it->second] = std::move(o);
+            return;
+        }
+        index[o.id] = data.size();
+        data.push_back(std::move(o));
+        removed.push_back(false);
+    };
+
+    std::string_view text(journalText);
+    while (!text.empty()) {
+        const size_t eol = text.find('\n');
+        if (eol == std::string_view::npos) break; // torn tail write, never acknowledged
+        std::string_view rest = text.substr(0, eol);
+        text.remove_prefix(eol + 1);
+
+        const std::string_view tag = nextField(rest);
+        if (tag == "U") {
+            if (auto o = Order::fromLine(rest)) put(std::move(*o));
+            else ++skipped;
+            continue;
+        }
+        int id = 0;
+        if (tag.size() != 1 || !parseInt(nextField(rest), id)) continue;
+
+        if (tag[0] == 'C') {
+            if (index.contains(id)) continue;
+            Order o;
+            o.id = id;
+            o.client = nextField(rest);
+            o.status = OrderStatus::New;
+            o.total = Money();
+            if (const auto createdAt = Timestamp::parse(rest)) o.createdAt = *createdAt;
+            else o.createdAtText = rest;
+            put(std::move(o));
+            continue;
+        }
+
+        const auto it = index.find(id);
+        if (it == index.end()) continue;
+        Order& o = data[it->second];
+        if (tag[0] == 'I') {
+            const std::string_view key = nextField(rest);
+            Money price;
+            if (const size_t at = rest.find('@'); at != std::string_view::npos) {
+                price = Money::parse(rest.substr(at + 1)).value_or(Money());
+                rest = rest.substr(0, at);
+            }
+            int qty = 0;
+            if (key.empty() || !parseInt(rest, qty)) continue;
+            if (qty > 0) o.items.insert_or_assign(key, qty, price);
+            else o.items.erase(key);
+            o.total = o.calcTotal();
+        } else if (tag[0] == 'S') {
+            if (const auto status = parseOrderStatus(rest)) o.status = *status;
+        } else if (tag[0] == 'D') {
+            removed[it->second] = true;
+            anyRemoved = true;
+            index.erase(it);
+        }
+    }
+
+    if (anyRemoved) {
+        size_t out = 0;
+        for (size_t i = 0; i < data.size(); ++i) {
+            if (removed[i]) continue;
+            if (out != i) data[out] = std::move(data[i]);
+            ++out;
+        }
+        data.resize(out);
+    }
+    return skipped;
+}
+
+void JournaledOrderRepository::save(const std::vector<Order>& data) {
+    snapshot_.save(data);
+    writeFileAtomically(journal_, {});
+    records_ = 0;
+}
+
+std::vector<Order> JournaledOrderRepository::load() {
+    std::vector<Order> v = snapshot_.load();
+    skipped_ = snapshot_.skippedOnLoad();
+    std::ifstream j(journal_, std::ios::binary);
+    if (!j) {
+        records_ = 0;
+        return v;
+    }
+    std::ostringstream buf;
+    buf << j.rdbuf();
+    const std::string text = buf.str();
+    records_ = static_cast<std::size_t>(std::ranges::count(text, '\n'));
+    skipped_ += replay(v, text);
+    return v;
+}
+
+bool JournaledOrderRepository::append(const std::vector<OrderMutation>& batch) {
+    if (records_ + batch.size() > compactEvery_) return false;
+    std::string lines;
+    for (const auto& m : batch) lines += encode(m);
+    appendFileDurably(journal_, lines);
+    records_ += batch.size();
+    return true;
+}
+
+bool JournaledOrderRepository::saveChanges(const std::vector<Order>& upserts, const std::vector<int>& removedIds) {
+    const size_t count = upserts.size() + removedIds.size();
+    if (records_ + count > compactEvery_) return false;
+    std::string lines;
+    for (const auto& o : upserts) {
+        lines += "U;";
+        o.appendLine(lines);
+        lines += '\n';
+    }
+    for (int id : removedIds) lines += encode(OrderMutation::remove(id));
+    appendFileDurably(journal_, lines);
+    records_ += count;
+    return true;
+}
@@ -0,0 +1,193 @@
+#include "include/infrastructure/OrderArchive.h"
+#include "include/infrastructure/BinOrderRepository.h"
+#include "include/infrastructure/DurableFile.h"
+#include "include/Errors/CustomExceptions.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+#include <zlib.h>
+
+namespace {
+
+constexpr char kSegmentMagic[4] = {'O', 'M', 'S', 'Z'};
+constexpr size_t kSegmentHeader = sizeof(kSegmentMagic) + sizeof(std::uint64_t);
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return {};
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+std::string compress(const std::string& raw) {
+    uLongf size = compressBound(static_cast<uLong>(raw.size()));
+    std::string out(kSegmentHeader + size, '\0');
+    std::memcpy(out.data(), kSegmentMagic, sizeof(kSegmentMagic));
+    const std::uint64_t rawSize = raw.size();
+    std::memcpy(out.data() + sizeof(kSegmentMagic), &rawSize, sizeof(rawSize));
+    if (compress2(reinterpret_cast<Bytef*>(out.data() + kSegmentHeader), &size,
+                  reinterpret_cast<const Bytef*>(raw.data()), static_cast<uLong>(raw.size()),
+                  Z_BEST_COMPRESSION) != Z_OK)
+        throw IoException("cannot compress archive segment");
+    out.resize(kSegmentHeader + size);
+    return out;
+}
+
+std::string decompress(const std::string& packed, const std::string& path) {
+    if (packed.size() < kSegmentHeader || std::memcmp(packed.data(), kSegmentMagic, sizeof(kSegmentMagic)) != 0)
+        throw IoException("not an archive segment: " + path);
+    std::uint64_t rawSize = 0;
+    std::memcpy(&rawSize, packed.data() + sizeof(kSegmentMagic), sizeof(rawSize));
+    std::string raw(rawSize, '\0');
+    uLongf size = static_cast<uLongf>(rawSize);
+    if (uncompress(reinterpret_cast<Bytef*>(raw.data()), &size,
+                   reinterpret_cast<const Bytef*>(packed.data() + kSegmentHeader),
+                   static_cast<uLong>(packed.size() - kSegmentHeader)) != Z_OK || size != rawSize)
+        throw IoException("corrupt archive segment: " + path);
+    return raw;
+}
+
+std::string_view nextField(std::string_view& line) {
+    const size_t pos = line.find(';');
+    const std::string_view field = line.substr(0, pos);
+    line.remove_prefix(pos == std::string_view::npos ? line.size() : pos + 1);
+    return field;
+}
+
+template<typename T>
+bool parseField(std::string_view& line, T& out) {
+    const std::string_view field = nextField(line);
+    const auto [p, ec] = std::from_chars(field.data(), field.data() + field.size(), out);
+    return ec == std::errc() && p == field.data() + field.size();
+}
+
+template<typename T>
+void appendField(std::string& out, T v) {
+    char buf[32];
+    const auto [p, ec] = std::to_chars(buf, buf + sizeof(buf), v);
+    out += ';';
+    out.append(buf, p);
+}
+
+bool parseField(std::string_view& line, Money& out) {
+    const auto v = Money::parse(nextField(line));
+    if (v) out = *v;
+    return v.has_value();
+}
+
+void appendField(std::string& out, Money v) {
+    out += ';';
+    v.appendTo(out);
+}
+
+void addTotals(StatusTotals& to, const StatusTotals& from) {
+    to.count += from.count;
+    to.revenue += from.revenue;
+}
+
+}
+
+std::string OrderArchive::manifestPath() const {
+    return (std::filesystem::path(dir_) / "manifest.txt").string();
+}
+
+// Re-read on demand rather than trusting an in-memory copy: an append that
+// was rolled back by the storage transaction never reaches the manifest.
+void OrderArchive::readManifest() {
+    if (manifestRead_) return;
+    segments_.clear();
+    const std::string text = readFile(manifestPath());
+    std::string_view rest(text);
+    while (!rest.empty()) {
+        const size_t eol = rest.find('\n');
+        if (eol == std::string_view::npos) break;
+        std::string_view line = rest.substr(0, eol);
+        rest.remove_prefix(eol + 1);
+
+        Segment s;
+        s.file = nextField(line);
+        if (s.file.empty()
+            || !parseField(line, s.orders) || !parseField(line, s.minId) || !parseField(line, s.maxId)
+            || !parseField(line, s.done.count) || !parseField(line, s.done.revenue)
+            || !parseField(line, s.canceled.count) || !parseField(line, s.canceled.revenue))
+            throw IoException("corrupt archive manifest: " + manifestPath());
+        segments_.push_back(std::move(s));
+    }
+    if (loadedSegments_ > segments_.size()) {
+        loadedSegments_ = 0;
+        orders_.clear();
+    }
+    manifestRead_ = true;
+}
+
+std::vector<Order> OrderArchive::loadSegment(const Segment& s) const {
+    const std::string path = (std::filesystem::path(dir_) / s.file).string();
+    const std::string packed = readFile(path);
+    if (packed.empty()) throw IoException("missing archive segment: " + path);
+    return BinOrderRepository::decode(decompress(packed, path), path);
+}
+
+void OrderArchive::append(const std::vector<Order>& closed) {
+    if (closed.empty()) return;
+    readManifest();
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir_, ec);
+
+    Segment s;
+    s.file = "segment-" + std::to_string(segments_.size() + 1) + ".bin.z";
+    s.orders = closed.size();
+    s.minId = closed.front().id;
+    s.maxId = closed.front().id;
+    for (const auto& o : closed) {
+        s.minId = std::min(s.minId, o.id);
+        s.maxId = std::max(s.maxId, o.id);
+        StatusTotals* t = o.status == OrderStatus::Done ? &s.done
+                          : o.status == OrderStatus::Canceled ? &s.canceled : nullptr;
+        if (t) {
+            ++t->count;
+            t->revenue += o.total;
+        }
+    }
+
+    std::string manifest = readFile(manifestPath());
+    manifest += s.file;
+    appendField(manifest, s.orders);
+    appendField(manifest, s.minId);
+    appendField(manifest, s.maxId);
+    appendField(manifest, s.done.count);
+    appendField(manifest, s.done.revenue);
+    appendField(manifest, s.canceled.count);
+    appendField(manifest, s.canceled.revenue);
+    manifest += '\n';
+
+    writeFileAtomically((std::filesystem::path(dir_) / s.file).string(),
+                        compress(BinOrderRepository::encode(closed)));
+    writeFileAtomically(manifestPath(), manifest);
+    manifestRead_ = false;
+}
+
+const std::vector<Order>& OrderArchive::orders() {
+    readManifest();
+    for (; loadedSegments_ < segments_.size(); ++loadedSegments_) {
+        auto loaded = loadSegment(segments_[loadedSegments_]);
+        orders_.insert(orders_.end(), std::make_move_iterator(loaded.begin()), std::make_move_iterator(loaded.end()));
+    }
+    return orders_;
+}
+
+ArchiveSummary OrderArchive::summary() {
+    readManifest();
+    ArchiveSummary sum;
+    for (const auto& s : segments_) {
+        sum.orders += s.orders;
+        sum.maxId = std::max(sum.maxId, s.maxId);
+        addTotals(sum.done, s.done);
+        addTotals(sum.canceled, s.canceled);
+    }
+    return sum;
+}
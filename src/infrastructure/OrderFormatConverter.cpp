@@ -0,0 +1,22 @@
+#include "include/infrastructure/OrderFormatConverter.h"
+#include "include/infrastructure/TxtOrderRepository.h"
+#include "include/infrastructure/BinOrderRepository.h"
+#include "include/Errors/CustomExceptions.h"
+
+// A conversion never drops orders: a source with unreadable records is left
+// as the only copy.
+void convertOrdersTxtToBin(const std::string& txtFile, const std::string& binFile) {
+    TxtOrderRepository txt(txtFile);
+    BinOrderRepository bin(binFile);
+    const auto orders = txt.load();
+    if (txt.skippedOnLoad() > 0) throw IoException("unreadable orders in " + txtFile);
+    bin.save(orders);
+}
+
+void convertOrdersBinToTxt(const std::string& binFile, const std::string& txtFile) {
+    BinOrderRepository bin(binFile);
+    TxtOrderRepository txt(txtFile);
+    const auto orders = bin.load();
+    if (bin.skippedOnLoad() > 0) throw IoException("unreadable orders in " + binFile);
+    txt.save(orders);
+}
@@ -1,23 +1,86 @@
 #include "include/infrastructure/TxtOrderRepository.h"
+#include "include/infrastructure/DurableFile.h"
 #include <fstream>
-#include <iomanip>
+#include <algorithm>
+#include <future>
+#include <iterator>
+#include <string_view>
+#include <thread>
 #include "include/Errors/CustomExceptions.h"
 
 void TxtOrderRepository::save(const std::vector<Order>& data) {
-    std::ofstream o(file_);
-    if (!o) throw IoException("cannot open file for write: " + file_);
-    o.setf(std::ios::fixed);
-    o << std::setprecision(2);
-    for (const auto& e : data) o << e.toLine() << '\n';
+    std::string out;
+    for (const auto& e : data) {
+        e.appendLine(out);
+        out += '\n';
+    }
+    writeFileAtomically(file_, out);
+}
+
+namespace {
+
+// Below this size per chunk, thread start-up costs more than the parse.
+constexpr size_t kMinChunkBytes = 1 << 20;
+
+struct ParsedChunk {
+    std::vector<Order> orders;
+    size_t skipped{0};
+};
+
+ParsedChunk parseChunk(std::string_view text) {
+    ParsedChunk c;
+    while (!text.empty()) {
+        const size_t eol = text.find('\n');
+        const std::string_view line = text.substr(0, eol);
+        text = eol == std::string_view::npos ? std::string_view() : text.substr(eol + 1);
+        if (auto oo = Order::fromLine(line)) c.orders.push_back(std::move(*oo));
+        else if (!line.empty() && line != "\r") ++c.skipped;
+    }
+    return c;
+}
+
 }
 
 std::vector<Order> TxtOrderRepository::load() {
-    std::vector<Order> v;
-    std::ifstream i(file_);
-    if (!i) return v;
-    std::string L;
-    while (std::getline(i, L)) {
-        if (auto oo = Order::fromLine(L)) v.push_back(*oo);
+    skipped_ = 0;
+    std::ifstream i(file_, std::ios::binary);
+    if (!i) return {};
+    const std::string text{std::istreambuf_iterator<char>(i), std::istreambuf_iterator<char>()};
+
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    const size_t chunks = std::clamp<size_t>(text.size() / kMinChunkBytes, 1, cores);
+    if (chunks == 1) {
+        ParsedChunk c = parseChunk(text);
+        skipped_ = c.skipped;
+        return std::move(c.orders);
+    }
+
+    // Split on line boundaries; each chunk is parsed on its own thread and
+    // the results are concatenated in file order.
+    std::vector<std::future<ParsedChunk>> parts;
+    parts.reserve(chunks);
+    const std::string_view all(text);
+    size_t begin = 0;
+    for (size_t k = 1; k <= chunks && begin < all.size(); ++k) {
+        size_t end = all.size();
+        if (k < chunks) {
+            end = all.find('\n', std::max(begin, all.size() * k / chunks));
+            end = end == std::string_view::npos ? all.size() : end + 1;
+        }
+        parts.push_back(std::async(std::launch::async, parseChunk, all.substr(begin, end - begin)));
+        begin = end;
+    }
+
+    std::vector<ParsedChunk> parsed;
+    parsed.reserve(parts.size());
+    size_t total = 0;
+    for (auto& part : parts) {
+        parsed.push_back(part.get());
+        total += parsed.back().orders.size();
+        skipped_ += parsed.back().skipped;
     }
+    std::vector<Order> v;
+    v.reserve(total);
+    for (auto& chunk : parsed) std::ranges::move(chunk.orders, std::back_inserter(v));
     return v;
 }
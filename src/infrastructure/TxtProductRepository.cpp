@@ -1,12 +1,10 @@
 #include "include/infrastructure/TxtProductRepository.h"
 #include "include/core/Product.h"
+#include "include/infrastructure/DurableFile.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <cctype>
-#include <locale>
-#include <iomanip>
-#include <cmath>
 #include "include/Errors/CustomExceptions.h"
 
 static inline void trim(std::string& s) {
@@ -20,16 +18,9 @@ static inline std::string toLower(std::string s) {
     return s;
 }
 
-static inline double parse_price(std::string s) {
-    trim(s);
-    std::ranges::replace(s, ',', '.');
+static inline Money parse_price(std::string s) {
     std::erase_if(s, [](unsigned char c){ return std::isspace(c); });
-    std::stringstream ss(s);
-    ss.imbue(std::locale::classic());
-    double v = 0.0;
-    ss >> v;
-    v = std::round(v * 100.0) / 100.0;
-    return v;
+    return Money::parse(s).value_or(Money());
 }
 
 static inline int parse_int(std::string s) {
@@ -59,20 +50,18 @@ std::map<std::string, Product, std::less<>> TxtProductRepository::load() {
         trim(name);
         if (name.empty()) continue;
         std::string key = toLower(name);
-        double price = parse_price(priceStr);
+        Money price = parse_price(priceStr);
         int stock = stockStr.empty() ? 0 : parse_int(stockStr);
         result[key] = Product(name, price, stock);
     }
     return result;
 }
 
-void TxtProductRepository::save(const std::map<std::string, Product, std::less<>>& data) {
-    std::ofstream out(file_);
-    if (!out) throw IoException("cannot open products file for write: " + file_);
-    out.setf(std::ios::fixed);
-    out << std::setprecision(2);
+void TxtProductRepository::save(const ProductCatalog& data) {
+    std::ostringstream out;
     for (const auto& [key, p] : data) {
         (void)key; // unused
         out << p.name << ";" << p.price << ";" << p.stock << "\n";
     }
+    writeFileAtomically(file_, out.str());
 }
@@ -1,12 +1,23 @@
 #include <QApplication>
 #include <QCoreApplication>
+#include <QMessageBox>
+#include <QStringList>
 #include "include/infrastructure/TxtOrderRepository.h"
+#include "include/infrastructure/JournaledOrderRepository.h"
+#include "include/infrastructure/BinOrderRepository.h"
+#include "include/infrastructure/OrderFormatConverter.h"
 #include "include/infrastructure/TxtProductRepository.h"
+#include "include/infrastructure/FileTransaction.h"
+#include "include/infrastructure/OrderArchive.h"
 #include "include/services/OrderService.h"
 #include "include/services/ProductService.h"
 #include "include/ui/MainWindow.h"
+#include "include/ui/UtilsQt.h"
+#include <charconv>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <string_view>
 
 int main(int argc, char *argv[]) {
     QApplication app(argc, argv);
@@ -15,18 +26,68 @@ int main(int argc, char *argv[]) {
 
     std::filesystem::path dbDir       = appDir / "db";
     std::filesystem::path ordersPath  = dbDir / "orders.txt";
+    std::filesystem::path ordersBinPath = dbDir / "orders.bin";
+    std::filesystem::path journalPath = dbDir / "orders.journal";
     std::filesystem::path productsPath= dbDir / "products.txt";
+    std::filesystem::path commitPath  = dbDir / "commit.pending";
+    std::filesystem::path archiveDir  = dbDir / "archive";
     std::filesystem::path reportsDir  = appDir / "reports";
 
     std::error_code ec;
     std::filesystem::create_directories(dbDir, ec);
     std::filesystem::create_directories(reportsDir, ec);
 
+    // Finish a commit that was interrupted after its intent was recorded, so
+    // orders and products are loaded in a consistent state. An intent that
+    // cannot be applied is moved aside and reported: left in place it would
+    // make every later commit fail, since commit() recovers first.
+    FileTransaction storageTx(commitPath.string());
+    QStringList startupWarnings;
+    try {
+        storageTx.recover();
+    } catch (const std::exception& e) {
+        const auto failedPath = dbDir / "commit.pending.failed";
+        std::filesystem::rename(commitPath, failedPath, ec);
+        startupWarnings << (ec
+            ? QString("An interrupted save could not be completed (%1), and %2 could not be moved aside: "
+                      "saving will fail until it is removed.").arg(qs(e.what()), qs(commitPath.string()))
+            : QString("An interrupted save could not be completed (%1). Its data was kept in %2; "
+                      "orders and products may not include it.").arg(qs(e.what()), qs(failedPath.string())));
+    }
+
     if (!std::filesystem::exists(ordersPath))   { std::ofstream(ordersPath.string()).close(); }
     if (!std::filesystem::exists(productsPath)) { std::ofstream(productsPath.string()).close(); }
 
-    TxtOrderRepository orderRepo(ordersPath.string());
+    // --binary-orders switches the snapshot to the binary format, converting
+    // the text database once; an existing orders.bin keeps it switched on.
+    // --archive-after-days=N moves orders closed for longer than N days out
+    // of the working set (0 disables archiving).
+    bool binaryOrders = std::filesystem::exists(ordersBinPath);
+    int archiveAfterDays = 90;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (arg == "--binary-orders") binaryOrders = true;
+        constexpr std::string_view archiveFlag = "--archive-after-days=";
+        if (arg.starts_with(archiveFlag)) {
+            const std::string_view v = arg.substr(archiveFlag.size());
+            std::from_chars(v.data(), v.data() + v.size(), archiveAfterDays);
+        }
+    }
+    if (binaryOrders && !std::filesystem::exists(ordersBinPath)) {
+        try {
+            convertOrdersTxtToBin(ordersPath.string(), ordersBinPath.string());
+        } catch (const std::exception& e) {
+            (void)e;
+            binaryOrders = false;
+        }
+    }
+
+    TxtOrderRepository txtSnapshot(ordersPath.string());
+    BinOrderRepository binSnapshot(ordersBinPath.string());
+    IRepository& orderSnapshot = binaryOrders ? static_cast<IRepository&>(binSnapshot) : txtSnapshot;
+    JournaledOrderRepository orderRepo(orderSnapshot, journalPath.string());
     TxtProductRepository productRepo(productsPath.string());
+    OrderArchive orderArchive(archiveDir.string());
 
     ProductService productSvc(productRepo);
     try { 
@@ -38,6 +99,8 @@ int main(int argc, char *argv[]) {
 
     OrderService orderSvc(orderRepo);
     orderSvc.setProductService(&productSvc);
+    orderSvc.setStorageTransaction(&storageTx);
+    orderSvc.setArchive(&orderArchive);
     orderSvc.setPrices(productSvc.all());
     try { 
         orderSvc.load(); 
@@ -45,9 +108,26 @@ int main(int argc, char *argv[]) {
         // Ignore loading errors on startup - file may not exist yet
         (void)e;
     }
+    // Orders that could not be read would be lost by any rewrite, so orders
+    // stay read-only (and unarchived) until they are fixed.
+    if (orderSvc.readOnly()) {
+        startupWarnings << QString("%1 stored order(s) could not be read and were left out. Orders cannot be "
+                                   "changed until they are fixed in %2 and the program is restarted.")
+                               .arg(orderRepo.skippedOnLoad()).arg(qs(dbDir.string()));
+        archiveAfterDays = 0;
+    }
+    if (archiveAfterDays > 0) {
+        try {
+            orderSvc.archiveClosed(std::chrono::days(archiveAfterDays));
+        } catch (const std::exception& e) {
+            startupWarnings << QString("Closed orders could not be archived (%1). They stay in the order list; "
+                                       "archiving is tried again at the next start.").arg(qs(e.what()));
+        }
+    }
 
     MainWindow w(orderSvc, productSvc);
     w.show();
+    if (!startupWarnings.isEmpty()) QMessageBox::warning(&w, "storage", startupWarnings.join("\n\n"));
 
     return QApplication::exec();
 }
@@ -3,29 +3,194 @@
 #include "include/utils/validation_utils.h"
 #include <algorithm>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
-#include <ctime>
-#include <cmath>
 #include <format>
 #include <ranges>
 
-static std::string now_iso8601_srv() {
-    auto tp = std::chrono::system_clock::now();
-    std::time_t t = std::chrono::system_clock::to_time_t(tp);
-    std::tm lt{};
-#if defined(_WIN32)
-    localtime_s(&lt, &t);
-#else
-    localtime_r(&t, &lt);
-#endif
-    std::ostringstream os;
-    os << std::put_time(&lt, "%Y-%m-%dT%H:%M:%S");
-    return os.str();
+// A change that has no journal record (e.g. a repriced total): the order is
+// written out as a whole by the next flush.
+void OrderService::persist(int orderId) {
+    dirty_.insert(orderId);
+    journalable_ = false;
+    ++pendingRequests_;
+    if (unitDepth_ == 0) flush();
 }
 
-void OrderService::persist() {
-    save();
+void OrderService::persist(const OrderMutation& m) {
+    pendingMutations_.push_back(m);
+    if (m.kind == OrderMutation::Kind::Remove) {
+        dirty_.erase(m.orderId);
+        removed_.push_back(m.orderId);
+    } else {
+        dirty_.insert(m.orderId);
+    }
+    ++pendingRequests_;
+    if (unitDepth_ == 0) flush();
+}
+
+void OrderService::saveProducts() {
+    pendingProducts_ = true;
+    ++pendingRequests_;
+    if (unitDepth_ == 0) flush();
+}
+
+// Cheapest durable write first: journal records, then only the changed
+// orders, then the full rewrite for repositories that support neither.
+void OrderService::flush() {
+    if (readOnly())
+        throw IoException(std::format("{} stored order(s) could not be read; orders cannot be changed "
+                                      "until they are fixed", skippedOnLoad_));
+    const std::size_t issuedBefore = writeStats_.issued;
+    const std::size_t requests = pendingRequests_;
+    pendingRequests_ = 0;
+
+    if (pendingProducts_ && productService_) {
+        productService_->save();
+        ++writeStats_.issued;
+    }
+    pendingProducts_ = false;
+
+    // Archive first: without a storage transaction, a crash in between leaves
+    // an order in both stores rather than in neither.
+    if (!pendingArchive_.empty() && archive_) {
+        archive_->append(pendingArchive_);
+        stats_.addArchived(pendingArchive_);
+        if (rollupBuilt_) {
+            for (const Order& o : pendingArchive_) rollup_.add(o.createdAt, o.status, o.total);
+        }
+        ++writeStats_.issued;
+    }
+    pendingArchive_.clear();
+
+    if (!dirty_.empty() || !removed_.empty()) {
+        if (journalable_ && repo_.append(pendingMutations_)) {
+            ++writeStats_.issued;
+            clearPending();
+        } else {
+            std::vector<Order> changed;
+            changed.reserve(dirty_.size());
+            for (int id : dirty_) {
+                if (const Order* o = findById(id)) changed.push_back(*o);
+            }
+            if (repo_.saveChanges(changed, removed_)) {
+                ++writeStats_.issued;
+                clearPending();
+            } else {
+                saveAll();
+            }
+        }
+    }
+
+    if (const std::size_t writes = writeStats_.issued - issuedBefore; requests > writes)
+        writeStats_.coalesced += requests - writes;
+}
+
+void OrderService::rememberOrder(const Order& o) {
+    if (unitDepth_ > 0) undo_.push_back({UndoEntry::Kind::Changed, o, 0, 0});
+}
+
+void OrderService::rememberCreated(int id) {
+    if (unitDepth_ == 0) return;
+    UndoEntry e{UndoEntry::Kind::Created, {}, 0, 0};
+    e.order.id = id;
+    undo_.push_back(std::move(e));
+}
+
+void OrderService::rememberStock(ProductId productId) {
+    if (unitDepth_ > 0 && productService_)
+        undo_.push_back({UndoEntry::Kind::Stock, {}, productId, productService_->getStock(productId)});
+}
+
+OrderService::UnitMark OrderService::beginUnit() {
+    ++unitDepth_;
+    return {undo_.size(), pendingMutations_.size(), removed_.size(), pendingArchive_.size(),
+            dirty_, journalable_, pendingProducts_, repricedAt_};
+}
+
+void OrderService::commitUnit(const UnitMark& mark) {
+    if (unitDepth_ > 1) {
+        --unitDepth_;
+        return;
+    }
+    try {
+        unitDepth_ = 0;
+        if (storage_) storage_->begin();
+        flush();
+        if (storage_) storage_->commit();
+    } catch (const CommitPendingException&) {
+        // Past the commit point: the stores will match the new state, so
+        // memory keeps it and the caller is told the write is not done.
+        undo_.clear();
+        throw;
+    } catch (...) {
+        if (storage_) storage_->rollback();
+        if (archive_) stats_.setArchived(archive_->summary());
+        rollupBuilt_ = false;
+        ++unitDepth_;
+        rollbackUnit(mark);
+        throw;
+    }
+    undo_.clear();
+}
+
+void OrderService::rollbackUnit(const UnitMark& mark) {
+    --unitDepth_;
+    while (undo_.size() > mark.undo) {
+        UndoEntry& e = undo_.back();
+        switch (e.kind) {
+            case UndoEntry::Kind::Changed:
+                if (Order* o = findById(e.order.id)) {
+                    unindexItems(*o);
+                    *o = std::move(e.order);
+                    indexItems(*o);
+                    indexStatus(*o);
+                } else {
+                    const size_t slot = data_.emplace(std::move(e.order));
+                    indexSlot(slot);
+                    indexItems(data_[slot]);
+                    indexStatus(data_[slot]);
+                }
+                break;
+            case UndoEntry::Kind::Created:
+                if (const auto it = slotById_.find(e.order.id); it != slotById_.end()) {
+                    unindexItems(data_[it->second]);
+                    unindexStatus(e.order.id);
+                    const size_t slot = it->second;
+                    unindexSlot(slot);
+                    data_.erase(slot);
+                }
+                break;
+            case UndoEntry::Kind::Stock:
+                if (productService_ && productService_->findProduct(e.productId))
+                    productService_->setStock(e.productId, e.stock);
+                break;
+        }
+        undo_.pop_back();
+    }
+    pendingMutations_.resize(mark.mutations);
+    removed_.resize(mark.removed);
+    pendingArchive_.resize(mark.archived);
+    dirty_ = mark.dirty;
+    journalable_ = mark.journalable;
+    pendingProducts_ = mark.pendingProducts;
+    repricedAt_ = mark.repricedAt;
+    if (unitDepth_ == 0) {
+        undo_.clear();
+        pendingRequests_ = 0;
+    }
+}
+
+void OrderService::saveAll() {
+    std::vector<Order> temp(data_.begin(), data_.end());
+    repo_.save(temp);
+    ++writeStats_.issued;
+    clearPending();
+}
+
+void OrderService::clearPending() {
+    pendingMutations_.clear();
+    dirty_.clear();
+    removed_.clear();
+    journalable_ = true;
 }
 
 Order& OrderService::create(const std::string& client) {
@@ -34,176 +199,394 @@ Order& OrderService::create(const std::string& client) {
     Order o;
     o.id = nextId_++;
     o.client = client;
-    o.status = "new";
-    o.total = 0;
-    o.createdAt = now_iso8601_srv();
-    data_.push_back(o);
-    persist();
-    return data_[data_.size() - 1];
+    o.status = OrderStatus::New;
+    o.total = Money();
+    o.createdAt = Timestamp::now();
+    UnitOfWork uow(*this);
+    const size_t slot = data_.emplace(std::move(o));
+    Order& created = data_[slot];
+    indexSlot(slot);
+    indexStatus(created);
+    rememberCreated(created.id);
+    persist(OrderMutation::create(created));
+    uow.commit();
+    return created;
 }
 
-void OrderService::setPrices(const std::map<std::string, Product, std::less<>>& products) {
-    price_.clear();
+// Updates the table in place, so only prices that actually changed get a new
+// version and make the totals of their orders stale.
+void OrderService::setPrices(const ProductCatalog& products) {
+    std::vector<ProductId> listed;
+    listed.reserve(products.size());
     for (const auto& [key, product] : products) {
-        price_[key] = product.price;
+        const auto k = ProductKeys::intern(key);
+        price_.set(k, product.price);
+        listed.push_back(k.id);
     }
+    price_.keepOnly(listed);
 }
 
-void OrderService::addItem(Order& o, const std::string& item, int qty) {
+void OrderService::addItem(Order& o, std::string_view item, int qty) {
     if (qty <= 0) throw ValidationException("qty must be positive");
-    std::string key = item;
-    std::ranges::transform(key, key.begin(), [](unsigned char c){ return std::tolower(c); });
-    if (auto it = price_.find(key); it == price_.end()) {
+    const auto product = ProductKeys::find(item);
+    if (!product || !price_.find(product->id)) {
         throw NotFoundException("item not found in product base");
     }
+    const std::string& key = *product->name;
+    const Money unitPrice = *price_.find(product->id);
     
-    if (o.status != "canceled") {
+    UnitOfWork uow(*this);
+    rememberOrder(o);
+    if (o.status != OrderStatus::Canceled) {
         if (!productService_) {
             throw ValidationException("product service not initialized");
         }
         
-        if (int availableStock = productService_->getStock(key); availableStock < qty) {
+        if (int availableStock = productService_->getStock(product->id); availableStock < qty) {
             throw ValidationException(std::format("not enough stock. Available: {}, needed: {}", availableStock, qty));
         }
         
         try {
-            productService_->decreaseStock(key, qty);
-            productService_->save();
+            rememberStock(product->id);
+            productService_->decreaseStock(product->id, qty);
+            saveProducts();
         } catch (const NotFoundException&) {
             throw ValidationException("product not found: " + key);
         }
     }
     
-    o.items[key] += qty;
-    o.total = o.calcTotal(price_);
-    o.total = std::round(o.total * 100.0) / 100.0;
-    persist();
+    // An open order's lines follow the current prices (see repriceOpenOrders);
+    // a closed order's line keeps the price it was placed at, and only a new
+    // line takes the current one.
+    const auto line = o.items.find(product->id);
+    const bool hasLine = line != o.items.end();
+    const int lineQty = (hasLine ? line.qty() : 0) + qty;
+    const Money linePrice = isClosed(o.status) && hasLine && line.price() != Money() ? line.price() : unitPrice;
+    o.items.insert_or_assign(key, lineQty, linePrice);
+    indexItem(product->id, o);
+    o.total = o.calcTotal();
+    indexStatus(o);
+    persist(OrderMutation::setItem(o.id, key, lineQty, linePrice));
+    uow.commit();
 }
 
-void OrderService::removeItem(Order& o, const std::string& name) {
-    std::string key = name;
-    std::ranges::transform(key, key.begin(), [](unsigned char c){ return std::tolower(c); });
-    const auto it = o.items.find(key);
+void OrderService::removeItem(Order& o, std::string_view name) {
+    const auto it = o.items.find(name);
     if (it == o.items.end()) {
         throw NotFoundException("item not found in this order");
     }
-    const int qty = it->second;
-    o.items.erase(it);
+    const std::string& key = it->first;
+    const int qty = it.qty();
+    const ProductId productId = it.id();
+    UnitOfWork uow(*this);
+    rememberOrder(o);
+    o.items.erase(key);
+    unindexItem(productId, o.id);
     
-    if (o.status != "canceled" && productService_) {
-        productService_->increaseStock(key, qty);
-        productService_->save();
+    if (o.status != OrderStatus::Canceled && productService_) {
+        rememberStock(productId);
+        productService_->increaseStock(productId, qty);
+        saveProducts();
     }
     
-    o.total = o.calcTotal(price_);
-    o.total = std::round(o.total * 100.0) / 100.0;
-    persist();
+    o.total = o.calcTotal();
+    indexStatus(o);
+    persist(OrderMutation::setItem(o.id, key, 0));
+    uow.commit();
 }
 
 void OrderService::returnItemsToStock(const Order& o) {
     if (!productService_) return;
-    for (const auto& [itemKey, qty] : o.items) {
-        productService_->increaseStock(itemKey, qty);
+    UnitOfWork uow(*this);
+    for (auto it = o.items.begin(); it != o.items.end(); ++it) {
+        rememberStock(it.id());
+        productService_->increaseStock(it.id(), it.qty());
     }
-    productService_->save();
+    saveProducts();
+    uow.commit();
 }
 
 void OrderService::removeItemsFromStock(const Order& o) {
     if (!productService_) return;
-    for (const auto& [itemKey, qty] : o.items) {
-        if (!productService_->hasEnoughStock(itemKey, qty)) {
-            const int available = productService_->getStock(itemKey);
+    UnitOfWork uow(*this);
+    for (auto it = o.items.begin(); it != o.items.end(); ++it) {
+        const auto [itemKey, qty] = *it;
+        if (!productService_->hasEnoughStock(it.id(), qty)) {
+            const int available = productService_->getStock(it.id());
             throw ValidationException(std::format("not enough stock for {}. Available: {}, needed: {}", itemKey, available, qty));
         }
-        productService_->decreaseStock(itemKey, qty);
+        rememberStock(it.id());
+        productService_->decreaseStock(it.id(), qty);
     }
-    productService_->save();
+    saveProducts();
+    uow.commit();
 }
 
-void OrderService::setStatus(Order& o, const std::string& s) {
-    ValidationService V;
-    V.validate_status(s);
-    
-    std::string oldStatus = o.status;
+void OrderService::setStatus(Order& o, OrderStatus s) {
+    UnitOfWork uow(*this);
+    rememberOrder(o);
+    const OrderStatus oldStatus = o.status;
+    unindexItems(o);
     o.status = s;
+    indexItems(o);
+    indexStatus(o);
     
     if (productService_) {
-        if (oldStatus == "canceled" && s != "canceled") {
-            try {
-                removeItemsFromStock(o);
-            } catch (const ValidationException&) {
-                o.status = oldStatus;
-                throw;
-            }
-        } else if (oldStatus != "canceled" && s == "canceled") {
+        if (oldStatus == OrderStatus::Canceled && s != OrderStatus::Canceled) {
+            removeItemsFromStock(o);
+        } else if (oldStatus != OrderStatus::Canceled && s == OrderStatus::Canceled) {
             returnItemsToStock(o);
         }
     }
     
-    persist();
+    persist(OrderMutation::setStatus(o.id, o.status));
+    uow.commit();
 }
 
 Order* OrderService::findById(int id) {
-    return find_if(data_, [id](const Order& o) { return o.id == id; });
+    const auto it = slotById_.find(id);
+    return it == slotById_.end() ? nullptr : &data_[it->second];
 }
 
 const Order* OrderService::findById(int id) const {
-    return find_if(data_, [id](const Order& o) { return o.id == id; });
+    const auto it = slotById_.find(id);
+    return it == slotById_.end() ? nullptr : &data_[it->second];
 }
 
-void OrderService::sortById() {
-    std::ranges::sort(data_, [](const Order& a, const Order& b) {
-        return a.id < b.id;
-    });
+std::vector<const Order*> OrderService::findByIdRange(int minId, int maxId) const {
+    std::vector<const Order*> out;
+    const auto first = std::ranges::lower_bound(sortedIds_, minId);
+    const auto last = std::ranges::upper_bound(sortedIds_, maxId);
+    if (first >= last) return out;
+    out.reserve(static_cast<size_t>(last - first));
+    for (auto it = first; it != last; ++it) out.push_back(&data_[slotById_.at(*it)]);
+    return out;
 }
 
-double OrderService::revenue() const {
-    double s = 0;
-    for (const auto& o : data_) s += o.total;
-    return std::round(s * 100.0) / 100.0;
+std::vector<const Order*> OrderService::findByCreatedRange(Timestamp from, Timestamp to) const {
+    std::vector<const Order*> out;
+    const auto first = std::ranges::lower_bound(byCreated_, from, {}, &std::pair<Timestamp, int>::first);
+    const auto last = std::ranges::upper_bound(byCreated_, to, {}, &std::pair<Timestamp, int>::first);
+    if (first >= last) return out;
+    out.reserve(static_cast<size_t>(last - first));
+    for (auto it = first; it != last; ++it) out.push_back(&data_[slotById_.at(it->second)]);
+    return out;
 }
 
-void OrderService::recalculateOrdersWithProduct(const std::string& productKey) {
-    std::string key = productKey;
-    std::ranges::transform(key, key.begin(), [](unsigned char c){ return std::tolower(c); });
-    
-    bool changed = false;
-    for (auto& order : data_) {
-        if (order.items.contains(key)) {
-            double oldTotal = order.total;
-            order.total = order.calcTotal(price_);
-            order.total = std::round(order.total * 100.0) / 100.0;
-            if (std::abs(oldTotal - order.total) > 0.01) {
-                changed = true;
-            }
-        }
+std::size_t OrderService::countByCreatedRange(Timestamp from, Timestamp to) const {
+    const auto first = std::ranges::lower_bound(byCreated_, from, {}, &std::pair<Timestamp, int>::first);
+    const auto last = std::ranges::upper_bound(byCreated_, to, {}, &std::pair<Timestamp, int>::first);
+    return first < last ? static_cast<std::size_t>(last - first) : 0;
+}
+
+void OrderService::indexSlot(size_t slot) {
+    const Order& o = data_[slot];
+    slotById_[o.id] = slot;
+    if (sortedIds_.empty() || sortedIds_.back() < o.id) sortedIds_.push_back(o.id);
+    else sortedIds_.insert(std::ranges::lower_bound(sortedIds_, o.id), o.id);
+    const std::pair created{o.createdAt, o.id};
+    if (byCreated_.empty() || byCreated_.back() < created) byCreated_.push_back(created);
+    else byCreated_.insert(std::ranges::lower_bound(byCreated_, created), created);
+}
+
+// Drops the id and date entries of the order in `slot` before it is erased;
+// the other orders keep their slots, so their entries stay as they are.
+void OrderService::unindexSlot(size_t slot) {
+    const Order& o = data_[slot];
+    slotById_.erase(o.id);
+    if (const auto it = std::ranges::lower_bound(sortedIds_, o.id); it != sortedIds_.end() && *it == o.id)
+        sortedIds_.erase(it);
+    const std::pair created{o.createdAt, o.id};
+    if (const auto it = std::ranges::lower_bound(byCreated_, created); it != byCreated_.end() && *it == created)
+        byCreated_.erase(it);
+}
+
+void OrderService::reindex() {
+    slotById_.clear();
+    slotById_.reserve(data_.size());
+    sortedIds_.clear();
+    sortedIds_.reserve(data_.size());
+    byCreated_.clear();
+    byCreated_.reserve(data_.size());
+    for (auto it = data_.begin(); it != data_.end(); ++it) {
+        slotById_[it->id] = it.slot();
+        sortedIds_.push_back(it->id);
+        byCreated_.emplace_back(it->createdAt, it->id);
     }
-    
-    if (changed) {
-        persist();
+    std::ranges::sort(sortedIds_);
+    std::ranges::sort(byCreated_);
+}
+
+void OrderService::indexItem(ProductId productId, const Order& o) {
+    if (productId >= ordersByProduct_.size()) ordersByProduct_.resize(productId + 1);
+    ProductOrders& entry = ordersByProduct_[productId];
+    (isActive(o.status) ? entry.active : entry.closed).insert(o.id);
+}
+
+void OrderService::unindexItem(ProductId productId, int orderId) {
+    if (productId >= ordersByProduct_.size()) return;
+    ordersByProduct_[productId].active.erase(orderId);
+    ordersByProduct_[productId].closed.erase(orderId);
+}
+
+const OrderService::ProductOrders* OrderService::ordersWithProduct(std::string_view productKey) const {
+    const auto product = ProductKeys::find(productKey);
+    return product && product->id < ordersByProduct_.size() ? &ordersByProduct_[product->id] : nullptr;
+}
+
+void OrderService::indexItems(const Order& o) {
+    for (auto it = o.items.begin(); it != o.items.end(); ++it) indexItem(it.id(), o);
+}
+
+void OrderService::unindexItems(const Order& o) {
+    for (auto it = o.items.begin(); it != o.items.end(); ++it) unindexItem(it.id(), o.id);
+}
+
+// Upsert: the order's previous contribution is taken out first, so this can
+// be called after any change of status or total.
+void OrderService::indexStatus(const Order& o) {
+    unindexStatus(o.id);
+    byStatus_[statusIndex(o.status)].insert(o.id);
+    stats_.add(o.status, o.total);
+    if (rollupBuilt_) rollup_.add(o.createdAt, o.status, o.total);
+    statusOf_.emplace(o.id, IndexedStatus{o.status, o.total, o.createdAt});
+}
+
+void OrderService::unindexStatus(int orderId) {
+    const auto it = statusOf_.find(orderId);
+    if (it == statusOf_.end()) return;
+    byStatus_[statusIndex(it->second.status)].erase(orderId);
+    stats_.remove(it->second.status, it->second.total);
+    if (rollupBuilt_) rollup_.remove(it->second.createdAt, it->second.status, it->second.total);
+    statusOf_.erase(it);
+}
+
+const RevenueRollup& OrderService::rollup() const {
+    if (!rollupBuilt_) {
+        rollup_.clear();
+        for (const Order& o : archived()) rollup_.add(o.createdAt, o.status, o.total);
+        for (const Order& o : data_) rollup_.add(o.createdAt, o.status, o.total);
+        rollupBuilt_ = true;
     }
+    return rollup_;
 }
 
-void OrderService::save() {
-    std::vector<Order> temp;
-    for (const auto& o : data_) {
-        Order c = o;
-        c.total = c.calcTotal(price_);
-        c.total = std::round(c.total * 100.0) / 100.0;
-        temp.push_back(c);
+std::size_t OrderService::countByStatus(OrderStatus status) const {
+    return byStatus_[statusIndex(status)].size();
+}
+
+std::vector<const Order*> OrderService::ordersWithStatus(OrderStatus status) const {
+    const auto& ids = byStatus_[statusIndex(status)];
+    std::vector<const Order*> out;
+    out.reserve(ids.size());
+    for (int id : ids) out.push_back(findById(id));
+    return out;
+}
+
+std::vector<int> OrderService::activeOrdersWithProduct(std::string_view productKey) const {
+    const ProductOrders* indexed = ordersWithProduct(productKey);
+    if (!indexed) return {};
+    return {indexed->active.begin(), indexed->active.end()};
+}
+
+std::size_t OrderService::archiveClosed(std::chrono::hours minAge) {
+    if (!archive_) return 0;
+    const Timestamp cutoff = Timestamp::local(std::chrono::system_clock::now() - minAge);
+
+    UnitOfWork uow(*this);
+    std::size_t moved = 0;
+    for (auto it = data_.begin(); it != data_.end(); ++it) {
+        Order& o = *it;
+        // An order whose creation date could not be read has no known age.
+        if (isActive(o.status) || o.createdAtUnreadable() || o.createdAt >= cutoff) continue;
+        rememberOrder(o);
+        unindexItems(o);
+        unindexStatus(o.id);
+        persist(OrderMutation::remove(o.id));
+        unindexSlot(it.slot());
+        pendingArchive_.push_back(std::move(o));
+        data_.erase(it.slot());
+        ++moved;
     }
-    repo_.save(temp);
+    if (moved == 0) return 0;
+    uow.commit();
+    return moved;
+}
+
+const std::vector<Order>& OrderService::archived() const {
+    static const std::vector<Order> none;
+    return archive_ ? archive_->orders() : none;
+}
+
+std::size_t OrderService::repriceOpenOrders() {
+    UnitOfWork uow(*this);
+    std::size_t repriced = 0;
+    for (ProductId productId = 0; productId < ordersByProduct_.size(); ++productId) {
+        if (price_.changedAt(productId) <= repricedAt_) continue;
+        // Lines of a product that is no longer sold keep their price.
+        const Money* price = price_.find(productId);
+        if (!price) continue;
+        for (int id : ordersByProduct_[productId].active) {
+            Order& order = *findById(id);
+            const auto line = order.items.find(productId);
+            if (line == order.items.end() || line.price() == *price) continue;
+            rememberOrder(order);
+            order.items.setPrice(line, *price);
+            order.total = order.calcTotal();
+            indexStatus(order);
+            persist(order.id);
+            ++repriced;
+        }
+    }
+    repricedAt_ = price_.version();
+    uow.commit();
+    return repriced;
+}
+
+void OrderService::save() {
+    ++pendingRequests_;
+    if (unitDepth_ > 0) return;
+    flush();
 }
 
 void OrderService::load() {
     auto loaded = repo_.load();
+    skippedOnLoad_ = repo_.skippedOnLoad();
     data_.clear();
-    for (const auto& o : loaded) {
-        Order c = o;
-        c.total = c.calcTotal(price_);
-        c.total = std::round(c.total * 100.0) / 100.0;
-        
-        data_.push_back(c);
+    data_.reserve(loaded.size());
+    std::vector<int> unpriced;
+    // A stored total is the sum of the stored line prices, so it holds until
+    // a line gets a price here; nothing else is repriced at load.
+    for (auto& c : loaded) {
+        if (c.priceUnpricedLines(price_)) {
+            unpriced.push_back(c.id);
+            c.total = c.calcTotal();
+        }
         nextId_ = std::max(nextId_, c.id + 1);
+        data_.insert(std::move(c));
+    }
+    reindex();
+    ordersByProduct_.clear();
+    byStatus_ = {};
+    statusOf_.clear();
+    stats_.clearLive();
+    rollupBuilt_ = false;
+    for (const auto& o : data_) {
+        indexItems(o);
+        indexStatus(o);
+    }
+    if (archive_) {
+        stats_.setArchived(archive_->summary());
+        nextId_ = std::max(nextId_, stats_.archived().maxId + 1);
+    }
+    clearPending();
+    repricedAt_ = 0;
+
+    // Lines stored before price snapshots were just priced from the current
+    // table; write them back so later price edits leave them alone.
+    if (!unpriced.empty() && !readOnly()) {
+        UnitOfWork uow(*this);
+        for (int id : unpriced) persist(id);
+        uow.commit();
     }
 }
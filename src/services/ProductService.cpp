@@ -1,108 +1,134 @@
 #include "include/services/ProductService.h"
-#include <algorithm>
-#include <cmath>
-#include <ranges>
 
 ProductService::ProductService(IProductRepository& repo) : repo_(repo) {}
 
-const std::map<std::string, Product, std::less<>>& ProductService::all() const {
+const ProductCatalog& ProductService::all() const {
     return products_;
 }
 
-Product* ProductService::findProduct(const std::string& name) {
-    std::string key = name;
-    std::ranges::transform(key, key.begin(), [](unsigned char c){ return std::tolower(c); });
-    auto it = products_.find(key);
-    return it != products_.end() ? &it->second : nullptr;
+const Product* ProductService::findProduct(std::string_view name) const {
+    return products_.find(name);
 }
 
-const Product* ProductService::findProduct(const std::string& name) const {
-    std::string key = name;
-    std::ranges::transform(key, key.begin(), [](unsigned char c){ return std::tolower(c); });
-    auto it = products_.find(key);
-    return it != products_.end() ? &it->second : nullptr;
+const Product* ProductService::findProduct(ProductId id) const {
+    return products_.find(id);
+}
+
+std::optional<ProductId> ProductService::findId(std::string_view name) const {
+    return products_.idOf(name);
+}
+
+void ProductService::put(std::string_view name, Product product) {
+    if (const auto id = products_.idOf(name)) stats_.remove(*id, *products_.find(*id));
+    const ProductId id = products_.insert(name, std::move(product));
+    stats_.add(id, *products_.find(id));
+}
+
+bool ProductService::drop(std::string_view name) {
+    const auto id = products_.idOf(name);
+    if (!id) return false;
+    stats_.remove(*id, *products_.find(*id));
+    return products_.erase(name);
+}
+
+void ProductService::changeStock(ProductId id, Product& p, int stock) {
+    stats_.changeStock(id, p, stock);
+    p.stock = stock;
 }
 
 void ProductService::load() {
-    products_ = repo_.load();
-    std::map<std::string, Product, std::less<>> normalized;
-    for (const auto& [key, product] : products_) {
-        Product p = product;
-        p.price = std::round(p.price * 100.0) / 100.0;
-        if (p.price > 0.0) {
+    products_.clear();
+    stats_.clear();
+    for (auto& [key, product] : repo_.load()) {
+        Product p = std::move(product);
+        if (p.price > Money()) {
             if (p.stock < 0) p.stock = 0;
-            normalized[key] = p;
+            put(key, std::move(p));
         }
     }
-    products_.swap(normalized);
 }
 
 void ProductService::save() {
     repo_.save(products_);
 }
 
-void ProductService::addProduct(const std::string& name, double price, int stock) {
+void ProductService::addProduct(const std::string& name, Money price, int stock) {
     V_.validate_item_name(name);
     V_.validate_price(price);
     if (stock < 0) throw ValidationException("stock cannot be negative");
-    std::string key = name;
-    std::ranges::transform(key, key.begin(), [](unsigned char c){ return std::tolower(c); });
-    if (products_.contains(key))
+    if (products_.contains(name))
         throw ValidationException("product already exists");
-    double v = V_.normalize_money(price);
-    if (v <= 0.0) throw ValidationException("price must be positive");
-    products_[key] = Product(name, v, stock);
+    put(name, Product(name, price, stock));
 }
 
-void ProductService::removeProduct(const std::string& name) {
-    std::string key = name;
-    std::ranges::transform(key, key.begin(), [](unsigned char c){ return std::tolower(c); });
-    auto it = products_.find(key);
-    if (it == products_.end())
+void ProductService::removeProduct(std::string_view name) {
+    if (!drop(name))
         throw NotFoundException("product not found");
-    products_.erase(it);
 }
 
-void ProductService::updateProduct(const std::string& oldName, const std::string& newName, double newPrice, int stock) {
-    std::string oldKey = oldName;
-    std::string newKey = newName;
-    std::ranges::transform(oldKey, oldKey.begin(), [](unsigned char c){ return std::tolower(c); });
-    std::ranges::transform(newKey, newKey.begin(), [](unsigned char c){ return std::tolower(c); });
-    auto it = products_.find(oldKey);
-    if (it == products_.end())
+void ProductService::updateProduct(const std::string& oldName, const std::string& newName, Money newPrice, int stock) {
+    const Product* old = products_.find(oldName);
+    if (!old)
         throw NotFoundException("product not found");
     V_.validate_item_name(newName);
     V_.validate_price(newPrice);
-    double v = V_.normalize_money(newPrice);
-    Product p = it->second;
+    Product p = *old;
     p.name = newName;
-    p.price = v;
+    p.price = newPrice;
     if (stock >= 0) p.stock = stock;
-    products_.erase(it);
-    products_[newKey] = p;
+    drop(oldName);
+    put(newName, std::move(p));
 }
 
-void ProductService::decreaseStock(const std::string& name, int qty) {
-    Product* p = findProduct(name);
-    if (!p) throw NotFoundException("product not found");
-    if (p->stock < qty) throw ValidationException("not enough stock");
-    p->stock -= qty;
+void ProductService::decreaseStock(std::string_view name, int qty) {
+    const auto id = products_.idOf(name);
+    if (!id) throw NotFoundException("product not found");
+    decreaseStock(*id, qty);
 }
 
-void ProductService::increaseStock(const std::string& name, int qty) {
-    Product* p = findProduct(name);
-    if (!p) throw NotFoundException("product not found");
-    p->stock += qty;
+void ProductService::increaseStock(std::string_view name, int qty) {
+    const auto id = products_.idOf(name);
+    if (!id) throw NotFoundException("product not found");
+    increaseStock(*id, qty);
 }
 
-bool ProductService::hasEnoughStock(const std::string& name, int qty) const {
+bool ProductService::hasEnoughStock(std::string_view name, int qty) const {
     const Product* p = findProduct(name);
     if (!p) return false;
     return p->stock >= qty;
 }
 
-int ProductService::getStock(const std::string& name) const {
+int ProductService::getStock(std::string_view name) const {
     const Product* p = findProduct(name);
     if (!p) return 0;
     return p->stock;
 }
+
+void ProductService::setStock(ProductId id, int stock) {
+    Product* p = products_.find(id);
+    if (!p) throw NotFoundException("product not found");
+    changeStock(id, *p, stock);
+}
+
+void ProductService::decreaseStock(ProductId id, int qty) {
+    Product* p = products_.find(id);
+    if (!p) throw NotFoundException("product not found");
+    if (p->stock < qty) throw ValidationException("not enough stock");
+    changeStock(id, *p, p->stock - qty);
+}
+
+void ProductService::increaseStock(ProductId id, int qty) {
+    Product* p = products_.find(id);
+    if (!p) throw NotFoundException("product not found");
+    changeStock(id, *p, p->stock + qty);
+}
+
+bool ProductService::hasEnoughStock(ProductId id, int qty) const {
+    const Product* p = findProduct(id);
+    return p && p->stock >= qty;
+}
+
+int ProductService::getStock(ProductId id) const {
+    const Product* p = findProduct(id);
+    return p ? p->stock : 0;
+}
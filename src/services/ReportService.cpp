@@ -53,42 +53,39 @@ static void writeFiltersHeader(QTextStream& out, const ReportFilterInfo& filterI
     out << "To," << (filterInfo.useTo ? filterInfo.toDate.toString("yyyy-MM-dd HH:mm:ss") : "-") << "\n";
 }
 
-static QString formatOrderItems(const Order& order, const OrderService& orderService) {
+static QString formatOrderItems(const Order& order) {
     QString itemsStr;
     bool firstItem = true;
-    for (const auto& [key, value] : order.items) {
+    for (auto it = order.items.begin(); it != order.items.end(); ++it) {
+        const auto [key, value] = *it;
         if (!firstItem) itemsStr += "; ";
-        auto pit = orderService.price().find(key);
-        QString priceText = (pit != orderService.price().end())
-            ? QString::number(pit->second, 'f', 2)
-            : QString("n/a");
+        QString priceText = it.price() != Money() ? qs(it.price()) : QString("n/a");
         itemsStr += QString("%1 x%2 (@%3)").arg(qs(key)).arg(value).arg(priceText);
         firstItem = false;
     }
     return itemsStr.isEmpty() ? "-" : itemsStr;
 }
 
-static void writeOrderRow(QTextStream& out, const Order& order, const OrderService& orderService) {
-    QString itemsStr = formatOrderItems(order, orderService);
+static void writeOrderRow(QTextStream& out, const Order& order) {
+    QString itemsStr = formatOrderItems(order);
     QString client = escapeCsvField(qs(order.client));
     QString status = qs(order.status);
-    QString createdAt = qs(order.createdAt);
-    createdAt.replace("T", " ");
+    QString createdAt = order.createdAtUnreadable() ? escapeCsvField(qs(order.createdAtText)) : qs(order.createdAt);
     QString itemsStrEscaped = escapeCsvField(itemsStr);
 
     out << order.id << ","
         << client << ","
         << status << ","
-        << QString::number(order.total, 'f', 2) << ","
+        << qs(order.total) << ","
         << createdAt << ","
         << itemsStrEscaped << "\n";
 }
 
-static void writeSummarySection(QTextStream& out, int orderCount, double totalSum) {
+static void writeSummarySection(QTextStream& out, int orderCount, Money totalSum) {
     out << "\n";
     out << "Summary:\n";
     out << "Total Orders," << orderCount << "\n";
-    out << "Total Revenue," << QString::number(totalSum, 'f', 2) << "\n";
+    out << "Total Revenue," << qs(totalSum) << "\n";
 }
 
 QString ReportService::generateReport(
@@ -97,8 +94,7 @@ QString ReportService::generateReport(
     bool scopeFiltered,
     bool includeFiltersHeader,
     bool includeSummarySection,
-    const ReportFilterInfo& filterInfo,
-    const OrderService& orderService
+    const ReportFilterInfo& filterInfo
 ) {
     if (orders.isEmpty()) {
         return QString();
@@ -134,15 +130,15 @@ QString ReportService::generateReport(
 
     out << "Order ID,Client,Status,Total,Created At,Items\n";
 
-    double totalSum = 0.0;
-    QMap<QString, QPair<int,double>> statusAgg;
+    Money totalSum;
+    QMap<QString, QPair<int,Money>> statusAgg;
 
     for (const Order* op : orders) {
         const Order& o = *op;
         totalSum += o.total;
         statusAgg[qs(o.status)].first += 1;
         statusAgg[qs(o.status)].second += o.total;
-        writeOrderRow(out, o, orderService);
+        writeOrderRow(out, o);
     }
 
     if (includeSummarySection) {
@@ -41,7 +41,7 @@ AddProductDialog::AddProductDialog(ProductService& productSvc, QWidget* parent)
 void AddProductDialog::onAdd() {
     try {
         std::string name = formatName(ss(nameEdit_->text()));
-        double price = parsePrice(priceEdit_->text());
+        Money price = parsePrice(priceEdit_->text());
         bool ok = false;
         int stock = stockEdit_->text().toInt(&ok);
         if (!ok || stock < 0) stock = 0;
@@ -183,10 +183,8 @@ void EditOrderDialog::onApplyStatus() {
     try {
         Order* o = orderOrWarn();
         if (!o) return;
-        std::string st = ss(statusCombo_->currentText());
         ValidationService V;
-        V.validate_status(st);
-        svc_.setStatus(*o, st);
+        svc_.setStatus(*o, V.validate_status(ss(statusCombo_->currentText())));
         refreshItemsTable();
         QMessageBox::information(this, "ok", "status updated");
         emit dataChanged();
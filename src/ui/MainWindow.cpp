@@ -281,64 +281,56 @@ MainWindow::MainWindow(OrderService& svc, ProductService& productSvc, QWidget* p
     QTimer::singleShot(0, this, [this] { resizeEvent(nullptr); });
 }
 
-bool MainWindow::matchesClientFilter(const Order& o) const {
-    if (filterState_.activeClientFilter_.isEmpty()) return true;
-    QString c = qs(o.client);
-    return c.toLower().contains(filterState_.activeClientFilter_.toLower());
+bool MainWindow::isFilterActive() const {
+    return !filterState_.activeClientFilter_.isEmpty() || !filterState_.activeStatusFilter_.isEmpty()
+           || !filterState_.minTotalText_.isEmpty() || !filterState_.maxTotalText_.isEmpty()
+           || !filterState_.minIdText_.isEmpty() || !filterState_.maxIdText_.isEmpty()
+           || filterState_.useFrom_ || filterState_.useTo_;
 }
 
-bool MainWindow::matchesStatusFilter(const Order& o) const {
-    if (filterState_.activeStatusFilter_.isEmpty()) return true;
-    return qs(o.status).compare(filterState_.activeStatusFilter_, Qt::CaseInsensitive) == 0;
+// The archive only holds closed orders; the unfiltered table and filters on
+// active statuses never need to load it.
+bool MainWindow::filterReachesArchive() const {
+    if (!isFilterActive()) return false;
+    const auto status = filterState_.filter_.status();
+    return !status || isClosed(*status);
 }
 
-bool MainWindow::matchesTotalFilter(const Order& o) const {
-    if (!filterState_.minTotalText_.isEmpty()) {
-        QString t = filterState_.minTotalText_;
-        t.replace(',', '.');
-        bool b = false;
-        const double v = t.toDouble(&b);
-        if (b && o.total < v) return false;
-    }
-    if (!filterState_.maxTotalText_.isEmpty()) {
-        QString t = filterState_.maxTotalText_;
-        t.replace(',', '.');
-        bool b = false;
-        const double v = t.toDouble(&b);
-        if (b && o.total > v) return false;
+QList<const Order*> MainWindow::currentFilteredRows() const {
+    const OrderFilter& filter = filterState_.filter_;
+    // Start from the narrowest of the id-range, status and date-range indexes
+    // that have a filter set; only an unfiltered view walks every order.
+    QList<const Order*> rows;
+    std::vector<const Order*> candidates;
+    bool indexed = false;
+    if (const auto ids = filter.idRange()) {
+        candidates = svc_.findByIdRange(ids->first, ids->second);
+        indexed = true;
+    }
+    if (const auto status = filter.status()) {
+        if (!indexed || svc_.countByStatus(*status) < candidates.size()) {
+            candidates = svc_.ordersWithStatus(*status);
+            indexed = true;
+        }
     }
-    return true;
-}
-
-bool MainWindow::matchesIdFilter(const Order& o) const {
-    if (!filterState_.minIdText_.isEmpty()) {
-        bool b = false;
-        const int v = filterState_.minIdText_.toInt(&b);
-        if (b && o.id < v) return false;
+    if (const auto created = filter.createdRange()) {
+        if (!indexed || svc_.countByCreatedRange(created->first, created->second) < candidates.size()) {
+            candidates = svc_.findByCreatedRange(created->first, created->second);
+            indexed = true;
+        }
     }
-    if (!filterState_.maxIdText_.isEmpty()) {
-        bool b = false;
-        const int v = filterState_.maxIdText_.toInt(&b);
-        if (b && o.id > v) return false;
+    if (indexed) {
+        for (const Order* o : candidates) {
+            if (filter.matches(*o)) rows.push_back(o);
+        }
+    } else {
+        for (const auto& o : svc_.all()) {
+            if (filter.matches(o)) rows.push_back(&o);
+        }
     }
-    return true;
-}
-
-bool MainWindow::matchesDateFilter(const Order& o) const {
-    if (!filterState_.useFrom_ && !filterState_.useTo_) return true;
-    QDateTime created = QDateTime::fromString(qs(o.createdAt), Qt::ISODate);
-    if (filterState_.useFrom_ && created < filterState_.fromDate_) return false;
-    if (filterState_.useTo_ && created > filterState_.toDate_) return false;
-    return true;
-}
-
-QList<const Order*> MainWindow::currentFilteredRows() const {
-    const auto& all = svc_.all();
-    QList<const Order*> rows;
-    for (const auto& o : all) {
-        if (matchesClientFilter(o) && matchesStatusFilter(o) && matchesTotalFilter(o) && 
-            matchesIdFilter(o) && matchesDateFilter(o)) {
-            rows.push_back(&o);
+    if (filterReachesArchive()) {
+        for (const auto& o : svc_.archived()) {
+            if (filter.matches(o)) rows.push_back(&o);
         }
     }
     return rows;
@@ -359,11 +351,9 @@ void MainWindow::setupEmptyTableRow() {
 QString MainWindow::formatOrderItems(const Order& o) const {
     QString itemsStr;
     bool first = true;
-    for (const auto& [itemKey, qty] : o.items) {
-        const auto pit = svc_.price().find(itemKey);
-        const QString priceText = (pit != svc_.price().end())
-            ? QString::number(pit->second, 'f', 2)
-            : QString("n/a");
+    for (auto it = o.items.begin(); it != o.items.end(); ++it) {
+        const auto [itemKey, qty] = *it;
+        const QString priceText = it.price() != Money() ? qs(it.price()) : QString("n/a");
         if (!first) itemsStr += "\n";
         itemsStr += QString("%1 ×%2 (%3)")
             .arg(qs(itemKey))
@@ -377,18 +367,23 @@ QString MainWindow::formatOrderItems(const Order& o) const {
 QTableWidgetItem* MainWindow::createStatusCell(const Order& o) const {
     auto* statusCell = new QTableWidgetItem(qs(o.status));
     statusCell->setTextAlignment(Qt::AlignCenter);
-    if (o.status == "new") {
-        statusCell->setBackground(QColor("#388E3C"));
-        statusCell->setForeground(QBrush(Qt::white));
-    } else if (o.status == "in_progress") {
-        statusCell->setBackground(QColor("#FBC02D"));
-        statusCell->setForeground(QBrush(Qt::black));
-    } else if (o.status == "done") {
-        statusCell->setBackground(QColor("#1976D2"));
-        statusCell->setForeground(QBrush(Qt::white));
-    } else if (o.status == "canceled") {
-        statusCell->setBackground(QColor("#D32F2F"));
-        statusCell->setForeground(QBrush(Qt::white));
+    switch (o.status) {
+        case OrderStatus::New:
+            statusCell->setBackground(QColor("#388E3C"));
+            statusCell->setForeground(QBrush(Qt::white));
+            break;
+        case OrderStatus::InProgress:
+            statusCell->setBackground(QColor("#FBC02D"));
+            statusCell->setForeground(QBrush(Qt::black));
+            break;
+        case OrderStatus::Done:
+            statusCell->setBackground(QColor("#1976D2"));
+            statusCell->setForeground(QBrush(Qt::white));
+            break;
+        case OrderStatus::Canceled:
+            statusCell->setBackground(QColor("#D32F2F"));
+            statusCell->setForeground(QBrush(Qt::white));
+            break;
     }
     return statusCell;
 }
@@ -406,14 +401,26 @@ void MainWindow::populateTableRow(int row, const Order& o) {
     
     auto* statusCell = createStatusCell(o);
     
-    auto* totalCell = new NumericItem(o.total, QString::number(o.total, 'f', 2));
+    auto* totalCell = new NumericItem(o.total.toDouble(), qs(o.total));
     totalCell->setTextAlignment(Qt::AlignCenter);
     
-    QString createdAtStr = qs(o.createdAt);
-    createdAtStr.replace("T", " ");
-    auto* createdCell = new QTableWidgetItem(createdAtStr);
+    auto* createdCell = new QTableWidgetItem(o.createdAtUnreadable() ? qs(o.createdAtText) : qs(o.createdAt));
+    if (o.createdAtUnreadable()) {
+        createdCell->setForeground(QBrush(QColor("#D32F2F")));
+        createdCell->setToolTip("This creation date could not be read; it is kept as stored.");
+    }
     createdCell->setTextAlignment(Qt::AlignCenter);
     
+    table_->setItem(row, 0, idCell);
+    table_->setItem(row, 1, clientCell);
+    table_->setItem(row, 2, itemCell);
+    table_->setItem(row, 3, statusCell);
+    table_->setItem(row, 4, totalCell);
+    table_->setItem(row, 5, createdCell);
+
+    // Archived orders are read-only and not found by the edit dialog.
+    if (svc_.findById(o.id) != &o) return;
+
     auto* editBtn = createEditButton(this, "Edit order");
     connect(editBtn, &QPushButton::clicked, this, [this, orderId = o.id]() {
         if (const Order* order = svc_.findById(orderId); !order) {
@@ -436,12 +443,6 @@ void MainWindow::populateTableRow(int row, const Order& o) {
     layout->addStretch();
     layout->setAlignment(Qt::AlignCenter);
     
-    table_->setItem(row, 0, idCell);
-    table_->setItem(row, 1, clientCell);
-    table_->setItem(row, 2, itemCell);
-    table_->setItem(row, 3, statusCell);
-    table_->setItem(row, 4, totalCell);
-    table_->setItem(row, 5, createdCell);
     table_->setCellWidget(row, 6, widgetContainer);
 }
 
@@ -468,10 +469,7 @@ void MainWindow::refreshTable() {
         }
     }
 
-    bool filterActive = !filterState_.activeClientFilter_.isEmpty() || !filterState_.activeStatusFilter_.isEmpty()
-                        || !filterState_.minTotalText_.isEmpty() || !filterState_.maxTotalText_.isEmpty()
-                        || !filterState_.minIdText_.isEmpty() || !filterState_.maxIdText_.isEmpty()
-                        || filterState_.useFrom_ || filterState_.useTo_;
+    bool filterActive = isFilterActive();
 
     int foundCount = rows.size();
     if (filterActive) {
@@ -494,7 +492,9 @@ void MainWindow::refreshTable() {
             "}"
         );
     } else {
-        titleLabel_->setText(QString("Main Table (%1 orders)").arg((int)svc_.all().size()));
+        titleLabel_->setText(QString("Main Table (%1 orders, %2 archived)")
+                             .arg((int)svc_.all().size())
+                             .arg((int)svc_.archiveSummary().orders));
         clearFilterBtn_->setEnabled(false);
         clearFilterBtn_->setStyleSheet(
             "QPushButton:disabled {"
@@ -547,16 +547,14 @@ void MainWindow::onAddOrder() {
 
 
 void MainWindow::onOpenReportDialog() {
-    bool filterActive = !filterState_.activeClientFilter_.isEmpty() || !filterState_.activeStatusFilter_.isEmpty()
-                        || !filterState_.minTotalText_.isEmpty() || !filterState_.maxTotalText_.isEmpty()
-                        || !filterState_.minIdText_.isEmpty() || !filterState_.maxIdText_.isEmpty()
-                        || filterState_.useFrom_ || filterState_.useTo_;
+    bool filterActive = isFilterActive();
     ReportDialog dlg(filterActive, this);
     if (dlg.exec() != QDialog::Accepted) return;
 
     QList<const Order*> rows = dlg.scopeFiltered() ? currentFilteredRows() : QList<const Order*>{};
     if (!dlg.scopeFiltered()) {
         for (const auto& o : svc_.all()) rows.push_back(&o);
+        for (const auto& o : svc_.archived()) rows.push_back(&o);
     }
     if (rows.isEmpty()) {
         QMessageBox::information(this, "report", "nothing to report");
@@ -581,8 +579,7 @@ void MainWindow::onOpenReportDialog() {
         dlg.scopeFiltered(),
         dlg.includeFiltersHeader(),
         dlg.includeSummarySection(),
-        filterInfo,
-        svc_
+        filterInfo
     );
 
     if (fileName.isEmpty()) {
@@ -620,9 +617,7 @@ void MainWindow::onAddProduct() {
     if (dlg.exec() == QDialog::Accepted) {
         if (std::string addedName = dlg.addedProductName(); !addedName.empty()) {
             svc_.setPrices(productSvc_.all());
-            std::string key = addedName;
-            std::ranges::transform(key, key.begin(), ::tolower);
-            svc_.recalculateOrdersWithProduct(key);
+            svc_.repriceOpenOrders();
             svc_.save();
             refreshTable();
         }
@@ -632,12 +627,7 @@ void MainWindow::onAddProduct() {
 
 bool MainWindow::isProductUsedInActiveOrders(const std::string& productKey, QList<int>& affectedOrderIds) const {
     affectedOrderIds.clear();
-    const auto& orders = svc_.all();
-    for (const auto& order : orders) {
-        if ((order.status == "new" || order.status == "in_progress") && order.items.contains(productKey)) {
-            affectedOrderIds.append(order.id);
-        }
-    }
+    for (int id : svc_.activeOrdersWithProduct(productKey)) affectedOrderIds.append(id);
     return !affectedOrderIds.isEmpty();
 }
 
@@ -647,7 +637,7 @@ void MainWindow::cancelOrderSafely(int orderId) {
         return;
     }
     try {
-        svc_.setStatus(*order, "canceled");
+        svc_.setStatus(*order, OrderStatus::Canceled);
     } catch (const CustomException& e) {
         QMessageBox::warning(this, "error", QString("Failed to cancel order %1: %2")
                             .arg(orderId)
@@ -668,16 +658,18 @@ void MainWindow::onDeleteProduct(const std::string& productKey, const std::strin
             
             if (dialogResult.shouldCancelOrders) {
                 svc_.setProductService(&productSvc_);
+                OrderService::UnitOfWork uow(svc_);
                 for (int orderId : affectedOrderIds) {
                     cancelOrderSafely(orderId);
                 }
-                svc_.save();
+                uow.commit();
             }
         }
         
         productSvc_.removeProduct(productName);
         productSvc_.save();
         svc_.setPrices(productSvc_.all());
+        svc_.repriceOpenOrders();
         svc_.save();
         refreshProducts();
         refreshTable();
@@ -719,7 +711,7 @@ void MainWindow::handleProductEditSave(const QLineEdit* nameEdit, const QLineEdi
             return;
         }
         
-        double oldPrice = 0.0;
+        Money oldPrice;
         const Product* oldProduct = productSvc_.findProduct(oldName);
         if (oldProduct) {
             oldPrice = oldProduct->price;
@@ -729,17 +721,10 @@ void MainWindow::handleProductEditSave(const QLineEdit* nameEdit, const QLineEdi
         productSvc_.save();
         
         svc_.setPrices(productSvc_.all());
-        bool priceChanged = (oldProduct && std::abs(oldPrice - validation.price) > 0.01);
+        bool priceChanged = (oldProduct && oldPrice != validation.price);
         
         if (bool nameChanged = (oldName != validation.newName); priceChanged || nameChanged) {
-            if (nameChanged) {
-                std::string oldKey = oldName;
-                std::ranges::transform(oldKey, oldKey.begin(), ::tolower);
-                svc_.recalculateOrdersWithProduct(oldKey);
-            }
-            std::string newKey = validation.newName;
-            std::ranges::transform(newKey, newKey.begin(), ::tolower);
-            svc_.recalculateOrdersWithProduct(newKey);
+            svc_.repriceOpenOrders();
         }
         svc_.save();
         
@@ -754,60 +739,24 @@ void MainWindow::handleProductEditSave(const QLineEdit* nameEdit, const QLineEdi
 }
 
 void MainWindow::updateProductStatistics() {
-    const auto& products = productSvc_.all();
-    
-    std::vector<std::pair<std::string, Product>> productsVec;
-    for (const auto& [key, product] : products) {
-        productsVec.emplace_back(key, product);
-    }
-    
-    std::ranges::sort(productsVec, 
-        [](const auto& a, const auto& b) { return a.second.stock < b.second.stock; });
-    
-    QString lowStock = "Low Stock (Top 3):\n";
-    for (size_t i = 0; i < std::min(3UL, productsVec.size()); ++i) {
-        lowStock += QString("  • %1: %2\n").arg(qs(productsVec[i].second.name)).arg(productsVec[i].second.stock);
-    }
-    productStats_.lowStockLabel_->setText(lowStock);
-    
-    std::ranges::sort(productsVec, 
-        [](const auto& a, const auto& b) { return a.second.stock > b.second.stock; });
-    
-    QString highStock = "High Stock (Top 3):\n";
-    for (size_t i = 0; i < std::min(3UL, productsVec.size()); ++i) {
-        highStock += QString("  • %1: %2\n").arg(qs(productsVec[i].second.name)).arg(productsVec[i].second.stock);
-    }
-    productStats_.highStockLabel_->setText(highStock);
-    
-    std::ranges::sort(productsVec, 
-        [](const auto& a, const auto& b) { return a.second.price > b.second.price; });
-    
-    QString expensive = "Most Expensive (Top 3):\n";
-    for (size_t i = 0; i < std::min(3UL, productsVec.size()); ++i) {
-        expensive += QString("  • %1: $%2\n").arg(qs(productsVec[i].second.name))
-                    .arg(QString::number(productsVec[i].second.price, 'f', 2));
-    }
-    productStats_.expensiveLabel_->setText(expensive);
-    
-    std::ranges::sort(productsVec, 
-        [](const auto& a, const auto& b) { return a.second.price < b.second.price; });
-    
-    QString cheap = "Cheapest (Top 3):\n";
-    for (size_t i = 0; i < std::min(3UL, productsVec.size()); ++i) {
-        cheap += QString("  • %1: $%2\n").arg(qs(productsVec[i].second.name))
-                .arg(QString::number(productsVec[i].second.price, 'f', 2));
-    }
-    productStats_.cheapLabel_->setText(cheap);
-    
-    int totalCount = products.size();
-    double totalValue = 0.0;
-    for (const auto& [key, product] : products) {
-        (void)key; // unused
-        totalValue += product.price * product.stock;
-    }
-    
-    productStats_.totalCountLabel_->setText(QString("Total Products: %1").arg(totalCount));
-    productStats_.totalValueLabel_->setText(QString("Total Value: $%1").arg(QString::number(totalValue, 'f', 2)));
+    const ProductStats& stats = productSvc_.stats();
+    const auto list = [this](QString text, const std::vector<ProductId>& ids, bool showPrice) {
+        for (ProductId id : ids) {
+            const Product* p = productSvc_.findProduct(id);
+            if (!p) continue;
+            text += showPrice ? QString("  • %1: $%2\n").arg(qs(p->name)).arg(qs(p->price))
+                              : QString("  • %1: %2\n").arg(qs(p->name)).arg(p->stock);
+        }
+        return text;
+    };
+
+    productStats_.lowStockLabel_->setText(list("Low Stock (Top 3):\n", stats.lowestStock(3), false));
+    productStats_.highStockLabel_->setText(list("High Stock (Top 3):\n", stats.highestStock(3), false));
+    productStats_.expensiveLabel_->setText(list("Most Expensive (Top 3):\n", stats.mostExpensive(3), true));
+    productStats_.cheapLabel_->setText(list("Cheapest (Top 3):\n", stats.cheapest(3), true));
+
+    productStats_.totalCountLabel_->setText(QString("Total Products: %1").arg((int)productSvc_.all().size()));
+    productStats_.totalValueLabel_->setText(QString("Total Value: $%1").arg(qs(stats.inventoryValue())));
 }
 
 void MainWindow::onOpenStatistics() {
@@ -820,26 +769,18 @@ void MainWindow::onOpenStatistics() {
 }
 
 void MainWindow::updateStatistics() {
-    int newCount = 0;
-    int inProgressCount = 0;
-    int doneCount = 0;
-    int canceledCount = 0;
-    double totalRevenue = 0.0;
-    
-    const auto& all = svc_.all();
-    for (const auto& o : all) {
-        if (o.status == "new") newCount++;
-        else if (o.status == "in_progress") inProgressCount++;
-        else if (o.status == "done") doneCount++;
-        else if (o.status == "canceled") canceledCount++;
-        totalRevenue += o.total;
-    }
+    const OrderStats& stats = svc_.stats();
+    const int newCount = (int)stats.count(OrderStatus::New);
+    const int inProgressCount = (int)stats.count(OrderStatus::InProgress);
+    const int doneCount = (int)stats.count(OrderStatus::Done);
+    const int canceledCount = (int)stats.count(OrderStatus::Canceled);
+    const Money totalRevenue = stats.revenue();
     
     orderStats_.newLabel_->setText(QString("New: %1").arg(newCount));
     orderStats_.inProgressLabel_->setText(QString("In Progress: %1").arg(inProgressCount));
     orderStats_.doneLabel_->setText(QString("Done: %1").arg(doneCount));
     orderStats_.canceledLabel_->setText(QString("Canceled: %1").arg(canceledCount));
-    orderStats_.totalRevenueLabel_->setText(QString("Total Revenue: $%1").arg(QString::number(totalRevenue, 'f', 2)));
+    orderStats_.totalRevenueLabel_->setText(QString("Total Revenue: $%1").arg(qs(totalRevenue)));
 }
 
 void MainWindow::applyFilters() {
@@ -853,6 +794,25 @@ void MainWindow::applyFilters() {
     filterState_.useTo_ = filterWidgets_.useToCheck_->isChecked();
     filterState_.fromDate_ = filterWidgets_.fromDateEdit_->dateTime();
     filterState_.toDate_ = filterWidgets_.toDateEdit_->dateTime();
+
+    const auto money = [](QString text) { return text.isEmpty() ? std::nullopt : toMoney(text.replace(',', '.')); };
+    const auto id = [](const QString& text) -> std::optional<int> {
+        bool ok = false;
+        const int v = text.toInt(&ok);
+        return ok ? std::optional(v) : std::nullopt;
+    };
+    const std::string client = ss(filterState_.activeClientFilter_);
+    OrderFilter::Spec spec;
+    spec.client = client;
+    if (!filterState_.activeStatusFilter_.isEmpty())
+        spec.status = parseOrderStatus(ss(filterState_.activeStatusFilter_.toLower()));
+    spec.minTotal = money(filterState_.minTotalText_);
+    spec.maxTotal = money(filterState_.maxTotalText_);
+    spec.minId = id(filterState_.minIdText_);
+    spec.maxId = id(filterState_.maxIdText_);
+    if (filterState_.useFrom_) spec.from = toTimestamp(filterState_.fromDate_);
+    if (filterState_.useTo_) spec.to = toTimestamp(filterState_.toDate_);
+    filterState_.filter_ = OrderFilter(spec);
     refreshTable();
 }
 
@@ -95,9 +95,7 @@ void ProductWindow::onAddProduct() {
     if (dlg.exec() == QDialog::Accepted) {
         if (std::string addedName = dlg.addedProductName(); !addedName.empty()) {
             orderSvc_.setPrices(productSvc_.all());
-            std::string key = addedName;
-            std::ranges::transform(key, key.begin(), ::tolower);
-            orderSvc_.recalculateOrdersWithProduct(key);
+            orderSvc_.repriceOpenOrders();
             orderSvc_.save();
             emit ordersChanged();
         }
@@ -108,12 +106,7 @@ void ProductWindow::onAddProduct() {
 
 bool ProductWindow::isProductUsedInActiveOrders(const std::string& productKey, QList<int>& affectedOrderIds) const {
     affectedOrderIds.clear();
-    const auto& orders = orderSvc_.all();
-    for (const auto& order : orders) {
-        if ((order.status == "new" || order.status == "in_progress") && order.items.contains(productKey)) {
-            affectedOrderIds.append(order.id);
-        }
-    }
+    for (int id : orderSvc_.activeOrdersWithProduct(productKey)) affectedOrderIds.append(id);
     return !affectedOrderIds.isEmpty();
 }
 
@@ -123,8 +116,8 @@ void ProductWindow::cancelOrderSafely(int orderId) {
         return;
     }
     try {
-        orderSvc_.setStatus(*order, "canceled");
-        if (order->status != "canceled") {
+        orderSvc_.setStatus(*order, OrderStatus::Canceled);
+        if (order->status != OrderStatus::Canceled) {
             QMessageBox::warning(this, "error", QString("Failed to cancel order %1").arg(orderId));
         }
     } catch (const CustomException& e) {
@@ -147,10 +140,11 @@ void ProductWindow::onDeleteProduct(const std::string& productKey, const std::st
             
             if (dialogResult.shouldCancelOrders) {
                 orderSvc_.setProductService(&productSvc_);
+                OrderService::UnitOfWork uow(orderSvc_);
                 for (int orderId : affectedOrderIds) {
                     cancelOrderSafely(orderId);
                 }
-                orderSvc_.save();
+                uow.commit();
                 emit ordersChanged();
             }
         }
@@ -158,6 +152,7 @@ void ProductWindow::onDeleteProduct(const std::string& productKey, const std::st
         productSvc_.removeProduct(productName);
         productSvc_.save();
         orderSvc_.setPrices(productSvc_.all());
+        orderSvc_.repriceOpenOrders();
         orderSvc_.save();
         refreshProducts();
         
@@ -198,7 +193,7 @@ void ProductWindow::handleProductEditSave(const QLineEdit* nameEdit, const QLine
             return;
         }
         
-        double oldPrice = 0.0;
+        Money oldPrice;
         const Product* oldProduct = productSvc_.findProduct(oldName);
         if (oldProduct) {
             oldPrice = oldProduct->price;
@@ -208,18 +203,11 @@ void ProductWindow::handleProductEditSave(const QLineEdit* nameEdit, const QLine
         productSvc_.save();
         
         orderSvc_.setPrices(productSvc_.all());
-        bool priceChanged = (oldProduct && std::abs(oldPrice - validation.price) > 0.01);
+        bool priceChanged = (oldProduct && oldPrice != validation.price);
         bool nameChanged = (oldName != validation.newName);
         
         if (priceChanged || nameChanged) {
-            if (nameChanged) {
-                std::string oldKey = oldName;
-                std::ranges::transform(oldKey, oldKey.begin(), ::tolower);
-                orderSvc_.recalculateOrdersWithProduct(oldKey);
-            }
-            std::string newKey = validation.newName;
-            std::ranges::transform(newKey, newKey.begin(), ::tolower);
-            orderSvc_.recalculateOrdersWithProduct(newKey);
+            orderSvc_.repriceOpenOrders();
         }
         orderSvc_.save();
         
@@ -3,6 +3,7 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
+#include <QComboBox>
 #include <QPushButton>
 #include <QShowEvent>
 #include <QPaintEvent>
@@ -13,17 +14,56 @@
 #include <QRect>
 #include <QColor>
 #include <QScrollArea>
+#include <QTabBar>
 #include <QTimer>
 #include <QLinearGradient>
 #include <algorithm>
 #include <cmath>
+#include <map>
+#include <numeric>
+
+namespace {
+constexpr int kTrendView = 1;
+constexpr std::array<const char*, kOrderStatusCount> kStatusNames{"New", "In Progress", "Done", "Canceled"};
+}
 
 StatisticsWindow::StatisticsWindow(OrderService& svc, QWidget* parent)
     : QMainWindow(parent), svc_(svc) {
     setWindowTitle("Statistics and Charts");
     
     auto* central = new QWidget(this);
-    new QVBoxLayout(central); // Layout is managed by Qt's parent-child relationship
+    auto* layout = new QVBoxLayout(central);
+
+    // The charts are painted on the window below this row; the tab picks which.
+    auto* viewRow = new QHBoxLayout();
+    views_ = new QTabBar(central);
+    views_->addTab("By Status");
+    views_->addTab("Revenue Trend");
+    viewRow->addWidget(views_);
+    viewRow->addStretch();
+    trendControls_ = new QWidget(central);
+    auto* trendRow = new QHBoxLayout(trendControls_);
+    trendRow->setContentsMargins(0, 0, 0, 0);
+    trendRow->addWidget(new QLabel("Trend by:", trendControls_));
+    granularityCombo_ = new QComboBox(trendControls_);
+    granularityCombo_->addItems({"Hour", "Day", "Month"});
+    granularityCombo_->setCurrentIndex(static_cast<int>(granularity_));
+    trendRow->addWidget(granularityCombo_);
+    trendControls_->hide();
+    viewRow->addWidget(trendControls_);
+    layout->addLayout(viewRow);
+    layout->addStretch();
+
+    connect(views_, &QTabBar::currentChanged, this, [this](int index) {
+        trendControls_->setVisible(index == kTrendView);
+        animationProgress_ = 0.0;
+        animationTimer_->start(16);
+    });
+    connect(granularityCombo_, &QComboBox::currentIndexChanged, this, [this](int index) {
+        granularity_ = static_cast<RollupGranularity>(index);
+        updateTrend();
+        update();
+    });
 
     updateStatistics();
     
@@ -32,28 +72,46 @@ StatisticsWindow::StatisticsWindow(OrderService& svc, QWidget* parent)
 
     setCentralWidget(central);
     setMinimumSize(800, 600);
-    resize(900, 700);
+    resize(900, 740);
 }
 
 void StatisticsWindow::updateStatistics() {
     stats_ = StatusStats();
-    const auto& all = svc_.all();
-    
-    for (const auto& o : all) {
-        if (o.status == "new") {
-            stats_.newCount++;
-            stats_.newRevenue += o.total;
-        } else if (o.status == "in_progress") {
-            stats_.inProgressCount++;
-            stats_.inProgressRevenue += o.total;
-        } else if (o.status == "done") {
-            stats_.doneCount++;
-            stats_.doneRevenue += o.total;
-        } else if (o.status == "canceled") {
-            stats_.canceledCount++;
-            stats_.canceledRevenue += o.total;
+    const OrderStats& stats = svc_.stats();
+    stats_.newCount = static_cast<int>(stats.count(OrderStatus::New));
+    stats_.newRevenue = stats.revenue(OrderStatus::New).toDouble();
+    stats_.inProgressCount = static_cast<int>(stats.count(OrderStatus::InProgress));
+    stats_.inProgressRevenue = stats.revenue(OrderStatus::InProgress).toDouble();
+    stats_.doneCount = static_cast<int>(stats.count(OrderStatus::Done));
+    stats_.doneRevenue = stats.revenue(OrderStatus::Done).toDouble();
+    stats_.canceledCount = static_cast<int>(stats.count(OrderStatus::Canceled));
+    stats_.canceledRevenue = stats.revenue(OrderStatus::Canceled).toDouble();
+    updateTrend();
+}
+
+void StatisticsWindow::updateTrend() {
+    trend_.clear();
+    const RevenueRollup& rollup = svc_.rollup();
+    const auto last = rollup.last(granularity_);
+    if (!last) return;
+
+    // 24 hours, 30 days or 12 months ending with the newest bucket.
+    constexpr std::int64_t kDay = 86400;
+    std::int64_t span = 23 * 3600;
+    if (granularity_ == RollupGranularity::Day) span = 29 * kDay;
+    else if (granularity_ == RollupGranularity::Month) span = 334 * kDay;
+    const Timestamp from = Timestamp::fromSeconds(last->seconds() - span);
+
+    std::map<std::int64_t, TrendBucket> buckets;
+    for (const auto status : kAllOrderStatuses) {
+        for (const auto& point : rollup.series(from, *last, granularity_, status)) {
+            TrendBucket& bucket = buckets[point.start.seconds()];
+            bucket.start = point.start;
+            bucket.revenue[statusIndex(status)] = point.totals.revenue.toDouble();
         }
     }
+    trend_.reserve(buckets.size());
+    for (const auto& [start, bucket] : buckets) trend_.push_back(bucket);
 }
 
 
@@ -126,12 +184,26 @@ void StatisticsWindow::paintEvent(QPaintEvent* event) {
     int margin = 50;
     int chartWidth = width() - 2 * margin;
     int chartHeight = 220;
-    int chartY = 40;
+    const int top = views_->mapTo(this, QPoint(0, views_->height())).y();
+    int chartY = top + 40;
     
     QColor newColor("#4CAF50");
     QColor inProgressColor("#FFC107");
     QColor doneColor("#2196F3");
     QColor canceledColor("#F44336");
+    const std::array<QColor, kOrderStatusCount> colors{newColor, inProgressColor, doneColor, canceledColor};
+
+    if (views_->currentIndex() == kTrendView) {
+        painter.setFont(QFont("Arial", 16, QFont::Bold));
+        painter.setPen(QPen(Qt::white));
+        painter.drawText(QRect(margin, chartY - 40, chartWidth, 30), Qt::AlignLeft | Qt::AlignVCenter, "Revenue Trend");
+        painter.setPen(QPen(Qt::white, 2));
+        painter.drawLine(margin, chartY - 10, margin + chartWidth, chartY - 10);
+        const int legendY = height() - 40;
+        drawTrendChart(painter, QRect(margin + 15, chartY + 10, chartWidth - 30, legendY - chartY - 50), colors);
+        drawLegend(painter, legendY, colors);
+        return;
+    }
     
     int barWidth = (chartWidth - 60) / 4;
     int maxCount = std::max({stats_.newCount, stats_.inProgressCount, stats_.doneCount, stats_.canceledCount, 1});
@@ -224,40 +296,60 @@ void StatisticsWindow::paintEvent(QPaintEvent* event) {
     painter.drawLine(margin, chartY - 10, margin + chartWidth, chartY - 10);
     painter.drawLine(margin, revenueChartY - 10, margin + chartWidth, revenueChartY - 10);
     
-    int legendY = revenueChartY + chartHeight + 80;
-    int legendX = margin + (chartWidth - 400) / 2;
-    int legendSpacing = 100;
-    
+    drawLegend(painter, revenueChartY + chartHeight + 80, colors);
+}
+
+void StatisticsWindow::drawLegend(QPainter& painter, int y, const std::array<QColor, kOrderStatusCount>& colors) const {
+    constexpr int spacing = 100;
+    const int x = (width() - 400) / 2;
     painter.setFont(QFont("Arial", 10, QFont::Bold));
-    painter.setPen(QPen(Qt::white));
-    
-    QRect legendRect1(legendX, legendY, 15, 15);
-    painter.fillRect(legendRect1, newColor);
-    painter.setPen(QPen(Qt::white, 1));
-    painter.drawRect(legendRect1);
-    painter.setPen(QPen(Qt::white));
-    painter.drawText(QRect(legendX + 20, legendY, 80, 15), Qt::AlignLeft | Qt::AlignVCenter, "New");
-    
-    QRect legendRect2(legendX + legendSpacing, legendY, 15, 15);
-    painter.fillRect(legendRect2, inProgressColor);
-    painter.setPen(QPen(Qt::white, 1));
-    painter.drawRect(legendRect2);
-    painter.setPen(QPen(Qt::white));
-    painter.drawText(QRect(legendX + legendSpacing + 20, legendY, 80, 15), Qt::AlignLeft | Qt::AlignVCenter, "In Progress");
-    
-    QRect legendRect3(legendX + 2 * legendSpacing, legendY, 15, 15);
-    painter.fillRect(legendRect3, doneColor);
-    painter.setPen(QPen(Qt::white, 1));
-    painter.drawRect(legendRect3);
-    painter.setPen(QPen(Qt::white));
-    painter.drawText(QRect(legendX + 2 * legendSpacing + 20, legendY, 80, 15), Qt::AlignLeft | Qt::AlignVCenter, "Done");
-    
-    QRect legendRect4(legendX + 3 * legendSpacing, legendY, 15, 15);
-    painter.fillRect(legendRect4, canceledColor);
-    painter.setPen(QPen(Qt::white, 1));
-    painter.drawRect(legendRect4);
-    painter.setPen(QPen(Qt::white));
-    painter.drawText(QRect(legendX + 3 * legendSpacing + 20, legendY, 80, 15), Qt::AlignLeft | Qt::AlignVCenter, "Canceled");
+    for (const auto status : kAllOrderStatuses) {
+        const int left = x + static_cast<int>(statusIndex(status)) * spacing;
+        const QRect swatch(left, y, 15, 15);
+        painter.fillRect(swatch, colors[statusIndex(status)]);
+        painter.setPen(QPen(Qt::white, 1));
+        painter.drawRect(swatch);
+        painter.drawText(QRect(left + 20, y, 80, 15), Qt::AlignLeft | Qt::AlignVCenter, kStatusNames[statusIndex(status)]);
+    }
+}
+
+void StatisticsWindow::drawTrendChart(QPainter& painter, const QRect& area,
+                                      const std::array<QColor, kOrderStatusCount>& colors) const {
+    if (trend_.empty()) {
+        painter.setPen(QPen(Qt::white));
+        painter.setFont(QFont("Arial", 10, QFont::Normal));
+        painter.drawText(area, Qt::AlignCenter, "No revenue in this period");
+        return;
+    }
+
+    double maxTotal = 1.0;
+    for (const auto& bucket : trend_)
+        maxTotal = std::max(maxTotal, std::accumulate(bucket.revenue.begin(), bucket.revenue.end(), 0.0));
+
+    const int slot = std::max(1, area.width() / static_cast<int>(trend_.size()));
+    const int barWidth = std::max(1, slot - 4);
+    const int labelEvery = std::max(1, 60 / slot);
+    const int baseY = area.bottom();
+
+    painter.setFont(QFont("Arial", 8, QFont::Normal));
+    for (std::size_t i = 0; i < trend_.size(); ++i) {
+        const int x = area.left() + static_cast<int>(i) * slot;
+        int top = baseY;
+        for (std::size_t s = 0; s < kOrderStatusCount; ++s) {
+            const auto height = static_cast<int>(trend_[i].revenue[s] * area.height() / maxTotal * animationProgress_);
+            if (height <= 0) continue;
+            painter.fillRect(QRect(x, top - height, barWidth, height), colors[s]);
+            top -= height;
+        }
+
+        if (i % static_cast<std::size_t>(labelEvery) != 0) continue;
+        const QString stamp = qs(trend_[i].start);
+        QString label = stamp.left(7);
+        if (granularity_ == RollupGranularity::Hour) label = stamp.mid(11, 5);
+        else if (granularity_ == RollupGranularity::Day) label = stamp.mid(5, 5);
+        painter.setPen(QPen(Qt::white));
+        painter.drawText(QRect(x - 20, baseY + 4, barWidth + 40, 14), Qt::AlignCenter, label);
+    }
 }
 
 void StatisticsWindow::drawAnimatedRevenueBar(QPainter& painter, const RevenueBarParams& params) const {